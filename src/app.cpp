@@ -2,17 +2,28 @@
 
 #include "lve_camera.hpp"
 #include "lve_buffer.hpp"
+#include "lve_hole_streamer.hpp"
+#include "lve_render_bvh.hpp"
+#include "lve_render_queue.hpp"
+#include "lve_scene_loader.hpp"
+#include "lve_thread_pool.hpp"
 #include "rendersystems/simple_render_system.hpp"
 #include "rendersystems/point_light_system.hpp"
 #include "rendersystems/transparent_render_system.hpp"
 #include "rendersystems/outline_render_system.hpp"
 #include "rendersystems/wireframe_render_system.hpp"
 #include "rendersystems/golfturf_render_system.hpp"
+#include "rendersystems/trajectory_render_system.hpp"
 
 //#include "controllers/orbit_controller.hpp"
 #include "controllers/keyboard_movement_controller.hpp"
 #include "controllers/golf_ball_controller.hpp"
 
+#include "physics/island_manager.hpp"
+#include "physics/round_recording.hpp"
+#include "physics/shot_solver.hpp"
+#include "physics/trajectory_preview.hpp"
+
 // libs
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -22,6 +33,7 @@
 // std
 #include <array>
 #include <chrono>
+#include <future>
 #include <thread>
 #include <cassert>
 #include <stdexcept>
@@ -30,22 +42,41 @@
 #include <stdlib.h>
 #include <time.h>
 
-#define MAX_HOLES 9
-
 namespace lve {
 
-    App::App() {
+    App::App() : App(Options{}) {}
+
+    App::App(const Options &options) : options{options} {
+        // models and colliders load on the thread pool while the rest of the setup runs. Only the objects every
+        // hole shares are loaded here, the holes themselves are streamed in by run() as the ball gets near them
+        LveSceneLoader sceneLoader{lveDevice, assets};
+        sceneLoader.start(options.scenePath, true);
+
         globalPool = LveDescriptorPool::Builder(lveDevice)
             .setMaxSets(LveSwapChain::MAX_FRAMES_IN_FLIGHT)
             .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, LveSwapChain::MAX_FRAMES_IN_FLIGHT)
             .build();
-        loadGameObjects();
+
+        sceneLoader.finish(scene, world);
+        sceneDescription = sceneLoader.getDescription();
+        sceneEntities = sceneLoader.getEntities();
     }
 
     App::~App() {}
 
     void App::run() {
-        srand(time(NULL));
+        // the seed goes into the recording so a replay gets the same random numbers
+        RoundRecording recording{};
+        bool replaying = !options.replayPath.empty();
+        if (replaying)
+        {
+            recording = RoundRecording::load(options.replayPath);
+        }
+        else
+        {
+            recording.seed = static_cast<uint32_t>(time(NULL));
+        }
+        srand(recording.seed);
         std::vector<std::unique_ptr<LveBuffer>> uboBuffers(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
         for (int i = 0; i < uboBuffers.size(); i++)
         {
@@ -89,104 +120,92 @@ namespace lve {
         WireframeRenderSystem wireframeRenderer{
             lveDevice, lveRenderer.getSwapChainRenderPass(), globalSetLayout->getDescriptorSetLayout()
         };
+        TrajectoryRenderSystem trajectoryRenderer{
+            lveDevice, lveRenderer.getSwapChainRenderPass(), globalSetLayout->getDescriptorSetLayout()
+        };
         LveCamera camera{};
         camera.setViewTarget(glm::vec3(-1.0f, -2.0f, 2.0f), glm::vec3(0.0f, 0.0f, 2.5f));
 
         auto viewerObject = LveGameObject::createGameObject();
-        viewerObject.transform.translation.z = -2.5f;
+        viewerObject.transform.setTranslation({ 0.0f, 0.0f, -2.5f });
         KeyboardMovementController cameraController{};
 
-        // setting up the game objects for each course
-        LveGameObject courses[9] = { LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject(),
-            LveGameObject::createGameObject()};
-        courses[0].tag = "c1";
-        courses[1].tag = "c2";
-        courses[2].tag = "c3";
-        courses[3].tag = "c4";
-        courses[4].tag = "c5";
-        courses[5].tag = "c6";
-        courses[6].tag = "c7";
-        courses[7].tag = "c8";
-        courses[8].tag = "c9";
-
-        CollisionManager collisionManager{};
-        std::vector<BoxCollider> colliders = CollisionManager::readCollidersFromFile("models/collision/hole1_colliders.boxc");
-        for (BoxCollider bc : colliders)
-        {
-            bc.gameObject = &courses[0];
-        }
-
-        loadColliders(colliders, "models/collision/hole2_colliders.boxc", &courses[1]);
-        loadColliders(colliders, "models/collision/hole3_colliders.boxc", &courses[2]);
-        loadColliders(colliders, "models/collision/hole4_colliders.boxc", &courses[3]);
-        loadColliders(colliders, "models/collision/hole5_colliders.boxc", &courses[4]);
-        loadColliders(colliders, "models/collision/hole6_colliders.boxc", &courses[5]);
-        loadColliders(colliders, "models/collision/hole7_colliders.boxc", &courses[6]);
-        loadColliders(colliders, "models/collision/hole8_colliders.boxc", &courses[7]);
-        loadColliders(colliders, "models/collision/hole9_colliders.boxc", &courses[8]);
-
         bool showCollisionDebug = false;
+        LveRenderBvh renderBvh{};
+        LveVisibleSet visibleSet{};
+        LveRenderQueue renderQueue{};
+        uint32_t lastDrawn = 0;
+        uint32_t lastCulled = 0;
         std::vector<LveModel*> staticColliderWireframes;
 
-        for (BoxCollider collider : colliders)
+        // every hole's colliders stay loaded while only the meshes are streamed, so the wireframes are made once
+        for (BoxCollider& collider : world.colliders)
         {
-            collisionManager.InsertStaticCollider(new BoxCollider(collider));
-
             staticColliderWireframes.push_back(collider.GetWireFrame(lveDevice, {0.0f, 1.0f, 0.0f}));
         }
-        collisionManager.buildStaticTree();
-
-        // triggers for each golf hole. They're not passed to the collision manager since we'll be handling these ourselves
-        BoxCollider goals[9] = {
-            BoxCollider({14.0f, 0.5f, 0.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({22.0f, 0.5f, 8.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({28.0f, -1.5f, -4.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({28.0f, 0.5f, -22.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({20.0f, 0.5f, -42.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({1.5f, 0.5f, -46.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({-10.0f, 0.5f, -31.5f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({-20.0f, 0.0f, -20.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f}),
-            BoxCollider({9.0f, 0.25f, -24.0f}, {1.0f, 0.0f, 0.0f, 0.15f}, {0.0f, 0.0f, 1.0f, 0.15f}, {0.0f, 1.0f, 0.0f, 0.25f})
-        };
 
-        for (BoxCollider collider : goals)
+        for (BoxCollider& collider : world.goals)
         {
             staticColliderWireframes.push_back(collider.GetWireFrame(lveDevice, {1.0f, 1.0f, 0.0f}));
         }
 
-        // direct refereces to objects I want to control
-        LveGameObject* playerBall = &(gameObjects.find(10)->second);
-        GolfBallController ballController{*playerBall, 0.1f};
+        // direct refereces to objects I want to control, looked up by name once here so the loop never has to
+        auto findObject = [this](const std::string& name) {
+            LveScene::Entity entity = scene.find(name);
+            if (entity.isNull()) {
+                throw std::runtime_error("scene is missing object: " + name);
+            }
+            return entity;
+        };
+        LveScene::Entity playerBall = findObject("golfBall");
+        GolfBallController ballController{scene, playerBall, world, 0.1f};
+
+        if (replaying)
+        {
+            // the same starting state the headless replay uses, so a round recorded anywhere plays back the same
+            ballController.resetState(recording.startPosition, recording.startCourse);
+            if (recording.ballRadius != ballController.getSimulationSettings().radius)
+            {
+                std::cout << "Warning: the recording's ball radius is " << recording.ballRadius << ", this scene's is "
+                    << ballController.getSimulationSettings().radius << ", so the replay won't match\n";
+            }
+        }
+        else
+        {
+            recording.ballRadius = ballController.getSimulationSettings().radius;
+            recording.startPosition = ballController.getState().position;
+            recording.startCourse = ballController.getCurrentCourse();
+        }
+
+        // loads the ball's hole (blocking, so it's drawn from the first frame) and starts on its neighbours
+        LveHoleStreamer holeStreamer{lveDevice, assets, scene, sceneDescription, sceneEntities};
+        holeStreamer.update(ballController.getCurrentCourse());
 
-        LveGameObject* ballAim = &(gameObjects.find(11)->second);
+        // only the player's ball is dynamic for now, but any other dynamic bodies should be registered here too
+        IslandManager islandManager{};
+        IslandManager::BodyId ballBody = islandManager.addBody(&ballController.getSleepState());
 
-        LveGameObject* ballPower = &(gameObjects.find(12)->second);
+        size_t replayTick = 0;
 
-        std::vector<LveGameObject*> transparentObjects{};
+        LveScene::Entity ballAimPivot = findObject("ballAimPivot");
+        LveScene::Entity ballAim = findObject("ballAim");
+
+        LveScene::Entity ballPower = findObject("ballPower");
+
+        // searches for a good shot from wherever the ball is resting when the player asks for a hint. The search
+        // runs on the pool so the frame isn't held up by it, and the hint is shown once it's done
+        ShotSolver shotSolver{world, LveThreadPool::global(), ballController.getSimulationSettings()};
+        ShotSolver::Settings hintSettings{};
+        hintSettings.maxPower = ballController.getMaxPower();
+        std::future<std::vector<ShotSolver::Candidate>> hint;
+
+        // predicted path for the shot being lined up, shown while the player is charging a swing
+        TrajectoryPreview trajectoryPreview{world, ballController.getSimulationSettings()};
 
         // keep track of the old keystate for the C key (to help simulate "OnKeyDown" events)
         bool keyStateC = false;
         bool keyStateKPAdd = false;
-
-        // starting location for each track
-        glm::vec3 tees[] = {
-            { 0.0f, -0.11f, 0.0f },
-            { 14.0f, -0.11f, 6.0f },
-            { 28.0f, -0.11f, 6.0f },
-            { 34.0f, -3.11f, -8.0f },
-            { 26.0f, -0.11f, -28.0f },
-            { 16.0f, -0.11f, -49.0f },
-            { -2.0f, -0.11f, -40.0f },
-            { -16.0f, -0.11f, -30.0f },
-            { -10.0f, -2.11f, -12.0f }};
-        int current_tee = 0;
+        bool keyStateH = false;
 
         auto currentTime = std::chrono::high_resolution_clock::now();
         float totalTime = 0;
@@ -196,6 +215,7 @@ namespace lve {
         std::cout << "  C    - switch between free camera and golf ball controls\n";
         std::cout << "Golf Ball Controls: \n  ARROW KEYS - rotate the camera\n";
         std::cout << "  SPACE - hold to charge your swing. While charging, use the ARROW KEYS to aim the ball and increase/decrease power\n";
+        std::cout << "  H     - suggest a shot. Turns the ball towards the best shot found and prints its power\n";
 
         while (!lveWindow.shouldClose()) {
             glfwPollEvents();
@@ -203,31 +223,37 @@ namespace lve {
             auto newTime = std::chrono::high_resolution_clock::now();
             // clamping frameTime to a maximum 0.1 seconds between frames to prevent some extreme edge cases in my collision system
             float frameTime = std::min(std::chrono::duration<float, std::chrono::seconds::period>(newTime - currentTime).count(), 0.1f);
-            totalTime += frameTime;
             currentTime = newTime;
 
-            if (playerBall->transform.translation.y > 0.2f)
+            // when replaying, the recorded tick decides how much time passes and what the player did
+            TickInput input{};
+            if (replaying)
             {
-                // ball reset plane
-                if (playerBall->transform.translation.y > 10)
+                if (replayTick < recording.ticks.size())
                 {
-                    ballController.resetBall();
+                    input = recording.ticks[replayTick++];
+                    frameTime = input.dt;
+                }
+                else
+                {
+                    // out of ticks, so hand the ball back to the player
+                    bool matches = hashBallState(ballController.getState()) == recording.finalStateHash;
+                    std::cout << "Replay finished after " << replayTick << " ticks, final state "
+                        << (matches ? "matches the recording" : "DOES NOT match the recording") << '\n';
+                    replaying = false;
                 }
-                // else if (!ballController.isMoving())
-                // {
-                //     current_tee = (current_tee + 1) % MAX_HOLES;
-                //     ballController.nextHole(tees[current_tee]);
-                // }
             }
+            totalTime += frameTime;
 
             // ============================
             // if the user pressed the C key, swap camera controls
             // ============================
+            bool toggleCamera = false;
             if (glfwGetKey(lveWindow.getGLFWwindow(), GLFW_KEY_C) == GLFW_PRESS)
             {
                 if (!keyStateC)
                 {
-                    ballController.isAttached = !ballController.isAttached;
+                    toggleCamera = true;
                     keyStateC = true;
                 }
             }
@@ -235,7 +261,11 @@ namespace lve {
             {
                 keyStateC = false;
             }
-            ballController.update(lveWindow.getGLFWwindow(), frameTime);
+
+            if (replaying ? input.toggleCamera : toggleCamera)
+            {
+                ballController.isAttached = !ballController.isAttached;
+            }
 
             if (glfwGetKey(lveWindow.getGLFWwindow(), GLFW_KEY_KP_ADD) == GLFW_PRESS)
             {
@@ -243,6 +273,14 @@ namespace lve {
                 {
                     showCollisionDebug = !showCollisionDebug;
                     keyStateKPAdd = true;
+                    if (showCollisionDebug)
+                    {
+                        for (const LveAssetCache::AssetInfo& asset : assets.getResidentAssets())
+                        {
+                            std::cout << asset.path << ": " << asset.bytes / 1024 << " KiB, " << asset.references << " references\n";
+                        }
+                        std::cout << "Models resident: " << assets.getResidentBytes() / 1024 << " KiB\n";
+                    }
                 }
             }
             else
@@ -250,22 +288,54 @@ namespace lve {
                 keyStateKPAdd = false;
             }
 
+            if (glfwGetKey(lveWindow.getGLFWwindow(), GLFW_KEY_H) == GLFW_PRESS)
+            {
+                if (!keyStateH && !replaying && !hint.valid() && ballController.isAttached && !ballController.isMoving())
+                {
+                    BallState start = ballController.getState();
+                    hint = LveThreadPool::global().submit([&shotSolver, start, hintSettings]() {
+                        return shotSolver.solve(start, hintSettings);
+                    });
+                }
+                keyStateH = true;
+            }
+            else
+            {
+                keyStateH = false;
+            }
+
+            if (hint.valid() && hint.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                std::vector<ShotSolver::Candidate> shots = hint.get();
+                // the player may have taken the shot while it was being worked out
+                if (!shots.empty() && ballController.isAttached && !ballController.isMoving())
+                {
+                    ballController.aimRotation.y = shots[0].shot.yaw;
+                    std::cout << "Suggested shot: " << shots[0].shot.power / ballController.getMaxPower() * 100.0f << "% power"
+                        << (shots[0].holed ? " (goes in!)" : "") << '\n';
+                }
+            }
+
             // ====================================
-            // Collision phase of the loop
-            //      for this game, I'm only checking collision between the ball and each box collider
+            // Simulation phase of the loop
+            //      the ball controller steps the physics (integration, collision against the course and goal checks)
+            //      a sleeping ball is resting on the course, so it's skipped entirely
             // ====================================
-            SphereCollider& sc = ballController.getCollider();
-            collisionManager.GetCollisions(sc, &GolfBallController::ForwardOnCollision, &ballController);
-
-            // check if the ball is in the goal
-            if (!ballController.isMoving())
+            if (!replaying)
             {
-                if (goals[current_tee].CollidesWith(sc))
+                input = ballController.readInput(lveWindow.getGLFWwindow(), frameTime);
+                input.toggleCamera = toggleCamera;
+                if (!options.recordPath.empty())
                 {
-                    current_tee = (current_tee + 1) % MAX_HOLES;
-                    ballController.nextHole(tees[current_tee]);
+                    recording.ticks.push_back(input);
                 }
             }
+            ballController.update(input);
+            if (!islandManager.isAsleep(ballBody))
+            {
+                islandManager.updateBody(ballBody, ballController.getVelocity(), ballController.isMoving(), frameTime);
+            }
+            islandManager.update();
 
             // if the player is currently focusing on the ball, pivot the camera around the ball
             // This could probably use its own controller, but as its behaviour is very specific to this case in the program
@@ -276,35 +346,55 @@ namespace lve {
                 float roll = ballController.aimRotation.x;
                 glm::vec3 aimingDir{sin(yaw), 0.0f, cos(yaw)};
                 glm::vec3 forwardDir{ aimingDir.x * cos(roll), -sin(roll), cos(roll) * aimingDir.z };
-                viewerObject.transform.translation = playerBall->transform.translation - (forwardDir * 3.0f);
-                camera.setViewTarget(viewerObject.transform.translation, playerBall->transform.translation);
+                glm::vec3 ballPosition = scene.transforms.get(playerBall).getTranslation();
+                viewerObject.transform.setTranslation(ballPosition - (forwardDir * 3.0f));
+                camera.setViewTarget(viewerObject.transform.getTranslation(), ballPosition);
 
                 if (ballController.showReticle())
                 {
-                    ballAim->isVisible = true;
-                    ballAim->transform.translation = playerBall->transform.translation;
-                    ballAim->transform.rotation.y = ballController.aimRotation.y;
-                    
-                    ballPower->isVisible = true;
-                    ballPower->transform.translation = playerBall->transform.translation + (aimingDir * 0.15f);
-                    ballPower->transform.rotation.y = ballController.aimRotation.y;
-                    ballPower->transform.scale.z = ballController.getPowerRatio() * 0.2f;
+                    // the reticle and power arrow hang off the pivot, which follows the ball on its own
+                    scene.transforms.get(ballAimPivot).setRotation({ 0.0f, ballController.aimRotation.y, 0.0f });
+                    scene.renderables.get(ballAim).isVisible = true;
+                    scene.renderables.get(ballPower).isVisible = true;
+                    auto& powerTransform = scene.transforms.get(ballPower);
+                    glm::vec3 powerScale = powerTransform.getScale();
+                    powerTransform.setScale({ powerScale.x, powerScale.y, ballController.getPowerRatio() * 0.2f });
+
+                    trajectoryPreview.update(ballController.getState(), ballController.getAimedShot());
                 }
                 else
                 {
-                    ballAim->isVisible = false;
-                    ballPower->isVisible = false;
+                    scene.renderables.get(ballAim).isVisible = false;
+                    scene.renderables.get(ballPower).isVisible = false;
+                    trajectoryPreview.clear();
                 }
             }
             else
             {
                 // otherwise we use default "flying" camera controls
                 cameraController.moveInPlaneXZ(lveWindow.getGLFWwindow(), frameTime, viewerObject);
-                camera.setViewYXZ(viewerObject.transform.translation, viewerObject.transform.rotation);
+                camera.setViewYXZ(viewerObject.transform.getTranslation(), viewerObject.transform.getRotation());
             }
 
             float aspect = lveRenderer.getAspectRatio();
             camera.setPerspectiveProjection(glm::radians(50.0f), aspect, 0.1f, 100.0f);
+
+            // the ball may have moved on to the next hole, which brings new holes into range and pushes old ones out
+            holeStreamer.update(ballController.getCurrentCourse());
+
+            // everything that moves has moved, so bring world matrices up to date (only changed subtrees are touched)
+            scene.updateWorldMatrices();
+
+            // cull once and queue the survivors for every mesh pass. The counts are printed with the collision debug view on
+            renderBvh.update(scene);
+            renderBvh.cull(scene, camera.getFrustum(), glm::vec3{ camera.getInverseView()[3] }, visibleSet);
+            if (showCollisionDebug && (visibleSet.drawn != lastDrawn || visibleSet.culled != lastCulled))
+            {
+                std::cout << "Drawn " << visibleSet.drawn << ", culled " << visibleSet.culled << '\n';
+                lastDrawn = visibleSet.drawn;
+                lastCulled = visibleSet.culled;
+            }
+            renderQueue.build(scene, visibleSet, camera);
             
             if (auto commandBuffer = lveRenderer.beginFrame())
             {
@@ -315,7 +405,8 @@ namespace lve {
                     commandBuffer,
                     camera,
                     globalDescriptorSets[frameIndex],
-                    gameObjects
+                    scene,
+                    renderQueue
                 };
 
                 // update
@@ -329,270 +420,36 @@ namespace lve {
                 
                 // render
                 lveRenderer.beginSwapChainRenderPass(commandBuffer);
-                simpleRenderSystem.renderGameObjects(frameInfo, 0);
-                golfTurfRenderSystem.renderGameObjects(frameInfo, 1, totalTime);
+                simpleRenderSystem.renderGameObjects(frameInfo);
+                golfTurfRenderSystem.renderGameObjects(frameInfo, totalTime);
                 outlineRenderer.renderGameObjects(frameInfo);
+                transparentRender.renderGameObjects(frameInfo);
                 //PointLightSystem.render(frameInfo);
                 if (showCollisionDebug)
                 {
                     wireframeRenderer.renderGameObjects(frameInfo, staticColliderWireframes);
                 }
+                if (ballController.isAttached)
+                {
+                    trajectoryRenderer.render(frameInfo, trajectoryPreview.getPoints(), trajectoryPreview.getVersion());
+                }
                 lveRenderer.endSwapChainRenderPass(commandBuffer);
                 lveRenderer.endFrame();
             }
         }
 
-        vkDeviceWaitIdle(lveDevice.device());
-    }
-
-    void App::loadGameObjects() {
-        std::shared_ptr<LveModel> lveModel;
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h1.obj");
-        auto h1 = LveGameObject::createGameObject();
-        h1.model = lveModel;
-        h1.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h1.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h1.materialId = 1;
-        gameObjects.emplace(h1.getId(), std::move(h1));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_bumpers.obj");
-        h1 = LveGameObject::createGameObject();
-        h1.model = lveModel;
-        h1.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h1.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h1.materialId = 0;
-        h1.outline = true;
-        gameObjects.emplace(h1.getId(), std::move(h1));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h2.obj");
-        auto h2 = LveGameObject::createGameObject();
-        h2.model = lveModel;
-        h2.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h2.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h2.materialId = 1;
-        gameObjects.emplace(h2.getId(), std::move(h2));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h3.obj");
-        auto h3 = LveGameObject::createGameObject();
-        h3.model = lveModel;
-        h3.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h3.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h3.materialId = 1;
-        gameObjects.emplace(h3.getId(), std::move(h3));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h4.obj");
-        auto h4 = LveGameObject::createGameObject();
-        h4.model = lveModel;
-        h4.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h4.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h4.materialId = 1;
-        gameObjects.emplace(h4.getId(), std::move(h4));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h5.obj");
-        auto h5 = LveGameObject::createGameObject();
-        h5.model = lveModel;
-        h5.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h5.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h5.materialId = 1;
-        gameObjects.emplace(h5.getId(), std::move(h5));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h6.obj");
-        auto h6 = LveGameObject::createGameObject();
-        h6.model = lveModel;
-        h6.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h6.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h6.materialId = 1;
-        gameObjects.emplace(h6.getId(), std::move(h6));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h7.obj");
-        auto h7 = LveGameObject::createGameObject();
-        h7.model = lveModel;
-        h7.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h7.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h7.materialId = 1;
-        gameObjects.emplace(h7.getId(), std::move(h7));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h8.obj");
-        auto h8 = LveGameObject::createGameObject();
-        h8.model = lveModel;
-        h8.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h8.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h8.materialId = 1;
-        gameObjects.emplace(h8.getId(), std::move(h8));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/course/course1r_h9.obj");
-        auto h9 = LveGameObject::createGameObject();
-        h9.model = lveModel;
-        h9.transform.translation = { 0.0f, 0.0f, 0.0f };
-        h9.transform.scale = { 1.0f, 1.0f, 1.0f };
-        h9.materialId = 1;
-        gameObjects.emplace(h9.getId(), std::move(h9));
-
-        lveModel = LveModel::createModelFromFile(lveDevice,
-            "models/ball.obj");
-        auto golfBall = LveGameObject::createGameObject();
-        golfBall.model = lveModel;
-        golfBall.transform.translation = {0.0f, -0.11f, 0.0f};
-        golfBall.transform.scale = {0.6f, 0.6f, 0.6f};
-        golfBall.specular = 1.0f;
-        golfBall.outline = true;
-        // id = 9
-        gameObjects.emplace(golfBall.getId(), std::move(golfBall));
-
-        lveModel = LveModel::createModelFromFile(lveDevice,
-            "models/ball_hold.obj");
-        auto ballAim = LveGameObject::createGameObject();
-        ballAim.model = lveModel;
-        ballAim.transform.translation = {0.0f, -0.1f, 0.0f};
-        ballAim.transform.scale = {0.12f, 0.1f, 0.12f};
-        // id = 10
-        gameObjects.emplace(ballAim.getId(), std::move(ballAim));
-
-        lveModel = LveModel::createModelFromFile(lveDevice,
-            "models/ball_power.obj");
-        auto ballPow = LveGameObject::createGameObject();
-        ballPow.model = lveModel;
-        ballPow.transform.translation = {0.0f, -0.1f, 0.1f};
-        ballPow.transform.scale = {0.12f, 0.1f, 0.12f};
-        // id = 11
-        gameObjects.emplace(ballPow.getId(), std::move(ballPow));
-
-        lveModel = LveModel::createModelFromFile(lveDevice,
-            "models/THE_CUBES.obj");
-        auto cubes = LveGameObject::createGameObject();
-        cubes.model = lveModel;
-        cubes.transform.translation = {0.0f, 1.0f, 0.0f};
-        cubes.transform.scale = {1.0f, 1.0f, 1.0f};
-        cubes.specular = 1.0f;
-        cubes.outline = true;
-        gameObjects.emplace(cubes.getId(), std::move(cubes));
-
-        lveModel = LveModel::createModelFromFile(lveDevice, "models/ballhole.obj");
-        auto go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 14.0f, 0.0f, 0.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 22.0f, 0.0f, 8.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 28.0f, -2.0f, -4.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 28.0f, 0.0f, -22.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 20.0f, 0.0f, -42.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 1.5f, 0.0f, -46.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { -10.0f, 0.0f, -31.5f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { -20.0f, -0.5f, -20.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        go = LveGameObject::createGameObject();
-        go.model = lveModel;
-        go.transform.translation = { 9.0f, -0.25f, -24.0f };
-        go.transform.scale = { 1.0f, 1.0f, 1.0f };
-        gameObjects.emplace(go.getId(), std::move(go));
-
-        // ==============================================
-        //              Let there be trees!
-        // ==============================================
-        lveModel = LveModel::createModelFromFile(lveDevice,
-            "models/tree.obj");
-
-        for (int i = 0; i < 0; i++)
-        {
-            auto tree = LveGameObject::createGameObject();
-            tree.model = lveModel;
-            tree.transform.translation = { 5.0f * i, 0.0f, 17.5f + (rand() % 100) / 20.0f };
-            tree.transform.scale = {1.0f, 1.0f, 1.0f};
-            gameObjects.emplace(tree.getId(), std::move(tree));
-        }
-
-        for (int i = 0; i < 0; i++)
+        if (hint.valid())
         {
-            auto tree = LveGameObject::createGameObject();
-            tree.model = lveModel;
-            tree.transform.translation = { -12.5f + (rand() % 100) / 20.0f, 0.0f, 5.0f - (5.0f * i)};
-            tree.transform.scale = {1.0f, 1.0f, 1.0f};
-            gameObjects.emplace(tree.getId(), std::move(tree));
+            // it uses the solver and the course world
+            hint.wait();
         }
+        vkDeviceWaitIdle(lveDevice.device());
 
-        // ================================================
-        //          Point lights created below
-        // ================================================
-        auto pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 1.0f, 1.0f, 1.0f };
-        pointLight.transform.translation = { 5.0f, -3.4f, 2.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 1.0f, 0.0f, 1.0f };
-        pointLight.transform.translation = { 22.0f, -3.4f, 11.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 1.0f, 0.0f, 1.0f };
-        pointLight.transform.translation = { 24.0f, -3.4f, 6.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 0.0f, 1.0f, 1.0f };
-        pointLight.transform.translation = { 34.75f, -3.4f, -2.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 0.0f, 1.0f, 1.0f };
-        pointLight.transform.translation = { 37.25f, -3.4f, -2.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 0.0f, 1.0f, 1.0f };
-        pointLight.transform.translation = { 34.75f, -3.4f, -10.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-
-        pointLight = LveGameObject::makePointLight();
-        pointLight.color = { 0.0f, 1.0f, 1.0f };
-        pointLight.transform.translation = { 37.25f, -3.4f, -10.0f };
-        gameObjects.emplace(pointLight.getId(), std::move(pointLight));
-    }
-
-    void App::loadColliders(std::vector<BoxCollider> &colliderList, const char filename[], LveGameObject* parent)
-    {
-        std::vector<BoxCollider> colliders2 = CollisionManager::readCollidersFromFile(filename);
-        for (BoxCollider bc : colliders2)
+        if (!options.recordPath.empty())
         {
-            bc.gameObject = parent;
-            colliderList.push_back(bc);
+            recording.finalStateHash = hashBallState(ballController.getState());
+            recording.save(options.recordPath);
+            std::cout << "Saved " << recording.ticks.size() << " ticks to " << options.recordPath << '\n';
         }
     }
 }  // namespace lve
\ No newline at end of file
@@ -1,16 +1,20 @@
 #pragma once
 
+#include "lve_asset_cache.hpp"
 #include "lve_device.hpp"
-#include "lve_game_object.hpp"
+#include "lve_scene.hpp"
+#include "lve_scene_description.hpp"
 #include "lve_window.hpp"
 #include "lve_renderer.hpp"
 #include "lve_descriptors.hpp"
 
 #include "collision/collision.hpp"
 #include "collision/collision_manager.hpp"
+#include "physics/course_world.hpp"
 
 // std
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace lve {
@@ -19,7 +23,17 @@ namespace lve {
     static constexpr int WIDTH = 800;
     static constexpr int HEIGHT = 600;
 
+    struct Options {
+      // save every tick of input to this file when the window closes
+      std::string recordPath;
+      // play back a recording instead of reading the keyboard
+      std::string replayPath;
+      // text or compiled scene to load, relative to the engine directory
+      std::string scenePath = CourseWorld::DEFAULT_COURSE;
+    };
+
     App();
+    explicit App(const Options &options);
     ~App();
 
     App(const App &) = delete;
@@ -28,15 +42,19 @@ namespace lve {
     void run();
 
   private:
-    void loadGameObjects();
-    void loadColliders(std::vector<BoxCollider> &colliderList, const char filename[], LveGameObject* parent);
+    Options options;
 
     LveWindow lveWindow{WIDTH, HEIGHT, "Untitled Golf Game"};
     LveDevice lveDevice{lveWindow};
     LveRenderer lveRenderer{ lveWindow, lveDevice };
+    LveAssetCache assets{lveDevice};
 
     // note: order of declarations matters
     std::unique_ptr<LveDescriptorPool> globalPool{};
-    LveGameObject::Map gameObjects;
+    LveScene scene;
+    CourseWorld world;
+    // kept for streaming holes in and out: the description, and the entity loaded for each object in it
+    SceneDescription sceneDescription;
+    std::vector<LveScene::Entity> sceneEntities;
   };
 }  // namespace lve
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <type_traits>
+
+// Shared by the benchmarks in this directory, which are each a standalone program
+namespace benchmark
+{
+    // results get added in here and printed at the end, which keeps the optimiser from throwing the work away
+    inline double sink = 0.0;
+
+    // average milliseconds per run. run can take the run's index, for work that changes from one run to the next
+    template <typename F>
+    float timeRuns(int runs, F&& run)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < runs; i++)
+        {
+            if constexpr (std::is_invocable_v<F&, int>)
+            {
+                run(i);
+            }
+            else
+            {
+                run();
+            }
+        }
+        return std::chrono::duration<float, std::chrono::milliseconds::period>(
+            std::chrono::high_resolution_clock::now() - start).count() / runs;
+    }
+}
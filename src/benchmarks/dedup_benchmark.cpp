@@ -0,0 +1,179 @@
+// Compares deduplicating OBJ vertices the old way, hashing every vertex into a std::unordered_map<Vertex, uint32_t>,
+// against LveVertexIndexMap keyed on the OBJ index triple, and checks that every corner ends up with the same
+// vertex either way.
+//
+// usage: dedup_benchmark [iterations] [obj files...]
+#include "benchmark_utils.hpp"
+#include "../lve_model.hpp"
+#include "../lve_utils.hpp"
+#include "../lve_vertex_index_map.hpp"
+
+// libs
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+// std
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace std
+{
+    template<>
+    struct hash<lve::LveModel::Vertex> {
+        size_t operator()(lve::LveModel::Vertex const& vertex) const {
+            size_t seed = 0;
+            lve::hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
+            return seed;
+        }
+    };
+}
+
+namespace
+{
+    using lve::LveModel;
+
+    // the same as LveModel::Builder::loadModel
+    LveModel::Vertex makeVertex(const tinyobj::attrib_t& attrib, const tinyobj::index_t& index)
+    {
+        LveModel::Vertex vertex{};
+        if (index.vertex_index >= 0)
+        {
+            vertex.position = {
+                attrib.vertices[3 * index.vertex_index + 0],
+                attrib.vertices[3 * index.vertex_index + 1],
+                attrib.vertices[3 * index.vertex_index + 2] };
+            vertex.color = {
+                attrib.colors[3 * index.vertex_index + 0],
+                attrib.colors[3 * index.vertex_index + 1],
+                attrib.colors[3 * index.vertex_index + 2] };
+        }
+        if (index.normal_index >= 0)
+        {
+            vertex.normal = {
+                attrib.normals[3 * index.normal_index + 0],
+                attrib.normals[3 * index.normal_index + 1],
+                attrib.normals[3 * index.normal_index + 2] };
+        }
+        if (index.texcoord_index >= 0)
+        {
+            vertex.uv = {
+                attrib.texcoords[2 * index.texcoord_index + 0],
+                attrib.texcoords[2 * index.texcoord_index + 1] };
+        }
+        return vertex;
+    }
+
+    void dedupByValue(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes, LveModel::Builder& builder)
+    {
+        builder.vertices.clear();
+        builder.indices.clear();
+        std::unordered_map<LveModel::Vertex, uint32_t> uniqueVertices{};
+        for (const auto& shape : shapes)
+        {
+            for (const auto& index : shape.mesh.indices)
+            {
+                LveModel::Vertex vertex = makeVertex(attrib, index);
+                if (uniqueVertices.count(vertex) == 0)
+                {
+                    uniqueVertices[vertex] = static_cast<uint32_t>(builder.vertices.size());
+                    builder.vertices.push_back(vertex);
+                }
+                builder.indices.push_back(uniqueVertices[vertex]);
+            }
+        }
+    }
+
+    void dedupByIndex(const tinyobj::attrib_t& attrib, const std::vector<tinyobj::shape_t>& shapes, LveModel::Builder& builder)
+    {
+        builder.vertices.clear();
+        builder.indices.clear();
+        size_t cornerCount = 0;
+        for (const auto& shape : shapes)
+        {
+            cornerCount += shape.mesh.indices.size();
+        }
+        builder.indices.reserve(cornerCount);
+        builder.vertices.reserve(attrib.vertices.size() / 3);
+
+        lve::LveVertexIndexMap uniqueVertices{ cornerCount };
+        for (const auto& shape : shapes)
+        {
+            for (const auto& index : shape.mesh.indices)
+            {
+                bool inserted;
+                builder.indices.push_back(uniqueVertices.findOrInsert(index.vertex_index, index.normal_index,
+                    index.texcoord_index, static_cast<uint32_t>(builder.vertices.size()), inserted));
+                if (inserted)
+                {
+                    builder.vertices.push_back(makeVertex(attrib, index));
+                }
+            }
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int runs = argc > 1 ? std::atoi(argv[1]) : 50;
+    std::vector<std::string> paths{};
+    for (int i = 2; i < argc; i++)
+    {
+        paths.push_back(argv[i]);
+    }
+    if (paths.empty())
+    {
+        paths = { ENGINE_DIR "models/course/course1r_bumpers.obj", ENGINE_DIR "models/rock_path.obj" };
+    }
+
+    bool allMatch = true;
+    for (const std::string& path : paths)
+    {
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn, err;
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str()))
+        {
+            std::cerr << "couldn't load " << path << ": " << warn << err << "\n";
+            return EXIT_FAILURE;
+        }
+
+        LveModel::Builder byValue{};
+        LveModel::Builder byIndex{};
+        float valueTime = benchmark::timeRuns(runs, [&]() {
+            dedupByValue(attrib, shapes, byValue);
+            benchmark::sink += byValue.vertices.size();
+        });
+        float indexTime = benchmark::timeRuns(runs, [&]() {
+            dedupByIndex(attrib, shapes, byIndex);
+            benchmark::sink += byIndex.vertices.size();
+        });
+
+        // the index triple can only split vertices the value hash would have merged (an OBJ listing the same
+        // position twice), never merge different ones, so every corner has to come out the same
+        bool match = byValue.indices.size() == byIndex.indices.size();
+        for (size_t i = 0; match && i < byValue.indices.size(); i++)
+        {
+            const LveModel::Vertex& a = byValue.vertices[byValue.indices[i]];
+            const LveModel::Vertex& b = byIndex.vertices[byIndex.indices[i]];
+            match = a == b;
+        }
+        allMatch = allMatch && match;
+
+        std::cout << path << ": " << byValue.indices.size() << " corners, " << runs << " runs\n";
+        std::cout << "  unordered_map<Vertex>: " << valueTime << " ms, " << byValue.vertices.size() << " vertices\n";
+        std::cout << "  LveVertexIndexMap:     " << indexTime << " ms, " << byIndex.vertices.size() << " vertices ("
+            << valueTime / indexTime << "x)\n";
+        std::cout << "  corners match: " << (match ? "yes" : "no") << "\n";
+    }
+    std::cout << "  (" << benchmark::sink << ")\n";
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
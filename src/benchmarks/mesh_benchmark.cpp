@@ -0,0 +1,115 @@
+// Reports what LveMeshOptimizer does to each model: ACMR (vertex shader runs per triangle in a FIFO cache of
+// LveMeshOptimizer::CACHE_SIZE) in file order and after the reorder, index bytes at 32 and at the width
+// LveModel picks, and how long it takes. Also checks the optimized mesh still has the same triangles.
+//
+// usage: mesh_benchmark [obj files or directories...]
+#include "benchmark_utils.hpp"
+#include "../lve_mesh_optimizer.hpp"
+#include "../lve_obj_reader.hpp"
+
+// std
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace
+{
+    using lve::LveModel;
+    using Triangle = std::array<float, 9>;
+
+    // every triangle by the positions of its corners, starting from the smallest corner so a triangle compares
+    // equal however the reorder rotated it (it never does, but it would still be the same triangle)
+    std::vector<Triangle> sortedTriangles(const LveModel::Builder& builder)
+    {
+        std::vector<Triangle> triangles{};
+        for (size_t i = 0; i + 2 < builder.indices.size(); i += 3)
+        {
+            std::array<std::array<float, 3>, 3> corners{};
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                const glm::vec3& position = builder.vertices[builder.indices[i + corner]].position;
+                corners[corner] = { position.x, position.y, position.z };
+            }
+            size_t first = std::min_element(corners.begin(), corners.end()) - corners.begin();
+            Triangle triangle{};
+            for (size_t corner = 0; corner < 3; corner++)
+            {
+                std::copy(corners[(first + corner) % 3].begin(), corners[(first + corner) % 3].end(), triangle.begin() + corner * 3);
+            }
+            triangles.push_back(triangle);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> roots{};
+    for (int i = 1; i < argc; i++)
+    {
+        roots.push_back(argv[i]);
+    }
+    if (roots.empty())
+    {
+        roots.push_back(ENGINE_DIR "models");
+    }
+
+    std::vector<std::string> paths{};
+    for (const std::string& root : roots)
+    {
+        if (!std::filesystem::is_directory(root))
+        {
+            paths.push_back(root);
+            continue;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root))
+        {
+            if (entry.is_regular_file() && entry.path().extension() == ".obj")
+            {
+                paths.push_back(entry.path().generic_string());
+            }
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    bool allMatch = true;
+    float totalBefore = 0.0f;
+    float totalAfter = 0.0f;
+    size_t totalTriangles = 0;
+    for (const std::string& path : paths)
+    {
+        LveModel::Builder builder{};
+        lve::LveObjReader::read(path, builder);
+        float before = lve::LveMeshOptimizer::computeAcmr(builder.indices, builder.vertices.size());
+        std::vector<Triangle> trianglesBefore = sortedTriangles(builder);
+
+        float time = benchmark::timeRuns(1, [&]() { lve::LveMeshOptimizer::optimize(builder); });
+        float after = lve::LveMeshOptimizer::computeAcmr(builder.indices, builder.vertices.size());
+        bool match = sortedTriangles(builder) == trianglesBefore;
+        allMatch = allMatch && match;
+
+        size_t triangles = builder.indices.size() / 3;
+        totalBefore += before * triangles;
+        totalAfter += after * triangles;
+        totalTriangles += triangles;
+        size_t indexSize = builder.vertices.size() <= 65536 ? 2 : 4;
+        std::cout << path << ": " << builder.vertices.size() << " vertices, " << triangles << " triangles\n";
+        std::cout << "  ACMR " << before << " -> " << after << ", index bytes " << builder.indices.size() * 4
+            << " -> " << builder.indices.size() * indexSize << ", " << time << " ms"
+            << (match ? "" : ", TRIANGLES CHANGED") << "\n";
+    }
+    if (totalTriangles > 0)
+    {
+        std::cout << paths.size() << " models, overall ACMR " << totalBefore / totalTriangles << " -> "
+            << totalAfter / totalTriangles << "\n";
+    }
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
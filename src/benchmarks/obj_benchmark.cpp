@@ -0,0 +1,128 @@
+// Compares loading OBJ files through tinyobjloader plus deduplication (what LveModel::Builder::loadModel used
+// to do) against LveObjReader, and checks both produce the same vertices and indices.
+//
+// usage: obj_benchmark [iterations] [obj files...]
+#include "benchmark_utils.hpp"
+#include "../lve_obj_reader.hpp"
+#include "../lve_thread_pool.hpp"
+#include "../lve_vertex_index_map.hpp"
+
+// libs
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+
+// std
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace
+{
+    using lve::LveModel;
+
+    bool loadWithTinyObj(const std::string& path, LveModel::Builder& builder)
+    {
+        tinyobj::attrib_t attrib;
+        std::vector<tinyobj::shape_t> shapes;
+        std::vector<tinyobj::material_t> materials;
+        std::string warn, err;
+        if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str()))
+        {
+            return false;
+        }
+
+        builder.vertices.clear();
+        builder.indices.clear();
+        size_t cornerCount = 0;
+        for (const auto& shape : shapes)
+        {
+            cornerCount += shape.mesh.indices.size();
+        }
+        lve::LveVertexIndexMap uniqueVertices{ cornerCount };
+        for (const auto& shape : shapes)
+        {
+            for (const auto& index : shape.mesh.indices)
+            {
+                bool inserted;
+                builder.indices.push_back(uniqueVertices.findOrInsert(index.vertex_index, index.normal_index,
+                    index.texcoord_index, static_cast<uint32_t>(builder.vertices.size()), inserted));
+                if (!inserted) continue;
+
+                LveModel::Vertex vertex{};
+                vertex.position = {
+                    attrib.vertices[3 * index.vertex_index + 0],
+                    attrib.vertices[3 * index.vertex_index + 1],
+                    attrib.vertices[3 * index.vertex_index + 2] };
+                vertex.color = {
+                    attrib.colors[3 * index.vertex_index + 0],
+                    attrib.colors[3 * index.vertex_index + 1],
+                    attrib.colors[3 * index.vertex_index + 2] };
+                if (index.normal_index >= 0)
+                {
+                    vertex.normal = {
+                        attrib.normals[3 * index.normal_index + 0],
+                        attrib.normals[3 * index.normal_index + 1],
+                        attrib.normals[3 * index.normal_index + 2] };
+                }
+                if (index.texcoord_index >= 0)
+                {
+                    vertex.uv = {
+                        attrib.texcoords[2 * index.texcoord_index + 0],
+                        attrib.texcoords[2 * index.texcoord_index + 1] };
+                }
+                builder.vertices.push_back(vertex);
+            }
+        }
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int runs = argc > 1 ? std::atoi(argv[1]) : 20;
+    std::vector<std::string> paths{};
+    for (int i = 2; i < argc; i++)
+    {
+        paths.push_back(argv[i]);
+    }
+    if (paths.empty())
+    {
+        paths = { ENGINE_DIR "models/course/course1r_bumpers.obj", ENGINE_DIR "models/rock_path.obj" };
+    }
+
+    bool allMatch = true;
+    for (const std::string& path : paths)
+    {
+        LveModel::Builder tinyObj{};
+        LveModel::Builder reader{};
+        if (!loadWithTinyObj(path, tinyObj))
+        {
+            std::cerr << "couldn't load " << path << "\n";
+            return EXIT_FAILURE;
+        }
+
+        float tinyObjTime = benchmark::timeRuns(runs, [&]() {
+            loadWithTinyObj(path, tinyObj);
+            benchmark::sink += tinyObj.vertices.size();
+        });
+        float readerTime = benchmark::timeRuns(runs, [&]() {
+            lve::LveObjReader::read(path, reader);
+            benchmark::sink += reader.vertices.size();
+        });
+
+        bool match = tinyObj.vertices == reader.vertices && tinyObj.indices == reader.indices;
+        allMatch = allMatch && match;
+
+        std::cout << path << ": " << reader.vertices.size() << " vertices, " << reader.indices.size() << " indices, "
+            << runs << " runs, " << lve::LveThreadPool::global().getConcurrency() << " threads\n";
+        std::cout << "  tinyobjloader: " << tinyObjTime << " ms\n";
+        std::cout << "  LveObjReader:  " << readerTime << " ms (" << tinyObjTime / readerTime << "x)\n";
+        std::cout << "  same mesh: " << (match ? "yes" : "no") << "\n";
+    }
+    std::cout << "  (" << benchmark::sink << ")\n";
+    return allMatch ? EXIT_SUCCESS : EXIT_FAILURE;
+}
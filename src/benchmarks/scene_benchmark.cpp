@@ -0,0 +1,105 @@
+// Compares iterating game objects in the old LveGameObject::Map against the dense LveScene component arrays,
+// doing the same filtering and matrix work the render systems and PointLightSystem do each frame.
+// There's no device to make models with, so the objects have none: on the map side anything that isn't a light
+// counts as a mesh, and on the scene side the render components LveScene::add would make are added directly.
+//
+// usage: scene_benchmark [object count] [frames]
+#include "benchmark_utils.hpp"
+#include "../lve_game_object.hpp"
+#include "../lve_scene.hpp"
+
+// std
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace
+{
+    lve::LveGameObject makeObject(int i)
+    {
+        // roughly the mix in the real course: mostly plain meshes, a quarter turf, a few outlined, a few lights
+        if (i % 100 == 0)
+        {
+            auto light = lve::LveGameObject::makePointLight(5.0f, 0.3f, glm::vec3{ 1.0f, 0.5f, 0.0f });
+            light.transform.setTranslation({ i * 0.01f, -3.0f, 0.0f });
+            return light;
+        }
+
+        auto object = lve::LveGameObject::createGameObject();
+        object.transform.setTranslation({ i * 0.01f, 0.0f, i * 0.02f });
+        object.transform.setRotation({ 0.0f, i * 0.1f, 0.0f });
+        object.materialId = (i % 4 == 0) ? 1 : 0;
+        object.outline = (i % 20 == 0);
+        return object;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    lve::LveGameObject::Map map;
+    lve::LveScene scene;
+    for (int i = 0; i < objectCount; i++)
+    {
+        auto object = makeObject(i);
+        map.emplace(object.getId(), makeObject(i));
+        bool mesh = object.pointLight == nullptr;
+        lve::RenderComponent render{};
+        render.materialId = object.materialId;
+        render.isVisible = object.isVisible;
+        bool outline = object.outline;
+        auto entity = scene.add(std::move(object));
+        if (mesh)
+        {
+            scene.renderables.add(entity, render);
+            if (outline) scene.outlines.add(entity);
+        }
+    }
+
+    // material 0 pass, material 1 pass, outline pass and the light update, like one frame of App::run
+    float mapTime = benchmark::timeRuns(frames, [&]() {
+        for (int material = 0; material < 2; material++) {
+            for (auto& kv : map) {
+                auto& obj = kv.second;
+                if (obj.pointLight != nullptr || !obj.isVisible || obj.materialId != material) continue;
+                benchmark::sink += obj.transform.mat4()[3][0];
+            }
+        }
+        for (auto& kv : map) {
+            auto& obj = kv.second;
+            if (obj.pointLight != nullptr || !obj.isVisible || !obj.outline) continue;
+            benchmark::sink += obj.transform.mat4()[3][0];
+        }
+        for (auto& kv : map) {
+            auto& obj = kv.second;
+            if (obj.pointLight == nullptr) continue;
+            benchmark::sink += obj.transform.getTranslation().x * obj.pointLight->lightIntensity;
+        }
+    });
+
+    float sceneTime = benchmark::timeRuns(frames, [&]() {
+        auto& renderables = scene.renderables;
+        for (int material = 0; material < 2; material++) {
+            for (size_t i = 0; i < renderables.size(); i++) {
+                auto& obj = renderables.data()[i];
+                if (!obj.isVisible || obj.materialId != material) continue;
+                benchmark::sink += scene.transforms.get(renderables.entityAt(i)).mat4()[3][0];
+            }
+        }
+        for (auto entity : scene.outlines.entities()) {
+            if (!scene.renderables.get(entity).isVisible) continue;
+            benchmark::sink += scene.transforms.get(entity).mat4()[3][0];
+        }
+        auto& lights = scene.pointLights;
+        for (size_t i = 0; i < lights.size(); i++) {
+            benchmark::sink += scene.transforms.get(lights.entityAt(i)).getTranslation().x * lights.data()[i].lightIntensity;
+        }
+    });
+
+    std::cout << objectCount << " objects, " << frames << " frames\n";
+    std::cout << "  unordered_map: " << mapTime << " ms per frame\n";
+    std::cout << "  LveScene:      " << sceneTime << " ms per frame (" << mapTime / sceneTime << "x)\n";
+    std::cout << "  (" << benchmark::sink << ")\n";
+    return EXIT_SUCCESS;
+}
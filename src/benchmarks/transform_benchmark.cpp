@@ -0,0 +1,87 @@
+// Compares computing model + normal matrices for a lot of moving objects one TransformComponent at a time
+// against LveTransformBatch, and checks the two agree.
+//
+// usage: transform_benchmark [object count] [frames]
+#include "benchmark_utils.hpp"
+#include "../lve_game_object.hpp"
+#include "../lve_thread_pool.hpp"
+#include "../lve_transform_batch.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+    // something swaying, so every object really does change every frame
+    glm::vec3 rotationAt(int object, int frame)
+    {
+        float t = frame * 0.016f + object * 0.37f;
+        return { 0.2f * std::sin(t), object * 0.1f + t, 0.1f * std::cos(t * 1.3f) };
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int objectCount = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int frames = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::vector<lve::TransformComponent> transforms(objectCount);
+    std::vector<glm::mat4> modelMatrices(objectCount);
+    std::vector<glm::mat4> normalMatrices(objectCount);
+    lve::LveTransformBatch batch{};
+    for (int i = 0; i < objectCount; i++)
+    {
+        glm::vec3 translation{ i * 0.01f, 0.0f, i * 0.02f };
+        glm::vec3 scale{ 1.0f + (i % 3) * 0.5f, 1.0f, 0.5f + (i % 5) * 0.25f };
+        transforms[i].setTranslation(translation);
+        transforms[i].setScale(scale);
+        batch.add(translation, glm::vec3{ 0.0f }, scale);
+    }
+
+    float singleTime = benchmark::timeRuns(frames, [&](int frame) {
+        for (int i = 0; i < objectCount; i++)
+        {
+            transforms[i].setRotation(rotationAt(i, frame));
+            modelMatrices[i] = transforms[i].mat4();
+            normalMatrices[i] = glm::mat4{ transforms[i].normalMatrix() };
+        }
+        benchmark::sink += modelMatrices[objectCount / 2][0][0];
+    });
+
+    float batchTime = benchmark::timeRuns(frames, [&](int frame) {
+        for (int i = 0; i < objectCount; i++)
+        {
+            glm::vec3 rotation = rotationAt(i, frame);
+            batch.rotationX[i] = rotation.x;
+            batch.rotationY[i] = rotation.y;
+            batch.rotationZ[i] = rotation.z;
+        }
+        batch.update();
+        benchmark::sink += batch.getModelMatrices()[objectCount / 2][0][0];
+    });
+
+    // both ran the same last frame, so they should agree
+    float maxError = 0.0f;
+    for (int i = 0; i < objectCount; i++)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                maxError = std::max(maxError, std::abs(modelMatrices[i][column][row] - batch.getModelMatrices()[i][column][row]));
+                maxError = std::max(maxError, std::abs(normalMatrices[i][column][row] - batch.getNormalMatrices()[i][column][row]));
+            }
+        }
+    }
+
+    std::cout << objectCount << " moving objects, " << frames << " frames, "
+        << lve::LveThreadPool::global().getConcurrency() << " threads\n";
+    std::cout << "  TransformComponent: " << singleTime << " ms per frame\n";
+    std::cout << "  LveTransformBatch:  " << batchTime << " ms per frame (" << singleTime / batchTime << "x)\n";
+    std::cout << "  max difference: " << maxError << "\n";
+    std::cout << "  (" << benchmark::sink << ")\n";
+    return EXIT_SUCCESS;
+}
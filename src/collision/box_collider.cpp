@@ -163,11 +163,97 @@ namespace lve
             collision.depth = otherLength - length;
         }
 
-        collision.gameObject = gameObject;
+        collision.courseIndex = courseIndex;
+        collision.colliderIndex = colliderIndex;
 
         return true;
     }
 
+    bool BoxCollider::GetTimeOfImpact(glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time)
+    {
+        // In the box's local space the sphere's centre moves along a quadratic on each axis, and it can only touch the box
+        // while it's inside all three slabs |x| <= halfWidth + radius. Growing the box by the radius is a little bigger
+        // than the real rounded shape at the edges and corners, so this can report a time that's early but never late.
+        // The set of times inside all three slabs starts either at 0 or at one of the slab crossings, so we only need
+        // to test those
+        glm::vec3 delta = start - position;
+
+        float a[3];
+        float b[3];
+        float c[3];
+        float width[3];
+
+        float candidates[13];
+        int count = 0;
+        candidates[count++] = 0.0f;
+
+        for (int i = 0; i < 3; i++)
+        {
+            glm::vec3 normal{ normals[i].x, normals[i].y, normals[i].z };
+            a[i] = 0.5f * glm::dot(acceleration, normal);
+            b[i] = glm::dot(velocity, normal);
+            c[i] = glm::dot(delta, normal);
+            width[i] = normals[i].w + radius;
+
+            for (float side : { -width[i], width[i] })
+            {
+                float c0 = c[i] - side;
+                if (std::abs(a[i]) < 1e-8f)
+                {
+                    if (std::abs(b[i]) > 1e-8f)
+                    {
+                        candidates[count++] = -c0 / b[i];
+                    }
+                    continue;
+                }
+
+                float discriminant = b[i] * b[i] - 4.0f * a[i] * c0;
+                if (discriminant < 0.0f)
+                {
+                    continue;
+                }
+
+                // the usual formula loses precision when b is much bigger than a, so get the other root from the product
+                float q = -0.5f * (b[i] + std::copysign(std::sqrt(discriminant), b[i]));
+                candidates[count++] = q / a[i];
+                if (q != 0.0f)
+                {
+                    candidates[count++] = c0 / q;
+                }
+            }
+        }
+
+        std::sort(candidates, candidates + count);
+
+        for (int n = 0; n < count; n++)
+        {
+            float t = candidates[n];
+            if (t < 0.0f)
+            {
+                continue;
+            }
+            if (t > maxTime)
+            {
+                break;
+            }
+
+            bool inside = true;
+            for (int i = 0; i < 3 && inside; i++)
+            {
+                float x = (a[i] * t + b[i]) * t + c[i];
+                inside = std::abs(x) <= width[i] * 1.0001f + 1e-5f;
+            }
+
+            if (inside)
+            {
+                time = t;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
     bool BoxCollider::CollidesWith(ICollider& other)
     {
         glm::vec3 d = other.position - position;
@@ -203,44 +289,4 @@ namespace lve
 
         return aabb;
     }
-
-    LveModel* BoxCollider::GetWireFrame(LveDevice& device, glm::vec3 color)
-    {
-        LveModel::Builder builder;
-
-        builder.vertices.push_back({position + axes[0] + axes[1] + axes[2], color});
-        builder.vertices.push_back({position + axes[0] + axes[1] - axes[2], color});
-        builder.vertices.push_back({position + axes[0] - axes[1] + axes[2], color});
-        builder.vertices.push_back({position + axes[0] - axes[1] - axes[2], color});
-        builder.vertices.push_back({position - axes[0] + axes[1] + axes[2], color});
-        builder.vertices.push_back({position - axes[0] + axes[1] - axes[2], color});
-        builder.vertices.push_back({position - axes[0] - axes[1] + axes[2], color});
-        builder.vertices.push_back({position - axes[0] - axes[1] - axes[2], color});
-
-        builder.indices.push_back(0);
-        builder.indices.push_back(1);
-        builder.indices.push_back(2);
-
-        builder.indices.push_back(5);
-        builder.indices.push_back(6);
-        builder.indices.push_back(7);
-
-        builder.indices.push_back(0);
-        builder.indices.push_back(4);
-        builder.indices.push_back(5);
-
-        builder.indices.push_back(2);
-        builder.indices.push_back(3);
-        builder.indices.push_back(7);
-
-        builder.indices.push_back(2);
-        builder.indices.push_back(4);
-        builder.indices.push_back(6);
-
-        builder.indices.push_back(1);
-        builder.indices.push_back(3);
-        builder.indices.push_back(5);
-
-        return new LveModel(device, builder);
-    }
 }
\ No newline at end of file
@@ -2,7 +2,6 @@
 
 #include "sphere_collider.hpp"
 #include "collision.hpp"
-#include "../lve_game_object.hpp"
 #include "quad_tree.hpp"
 #include "icollider.hpp"
 
@@ -10,6 +9,9 @@
 
 namespace lve
 {
+    class LveDevice;
+    class LveModel;
+
     class BoxCollider : public ICollider
     {
     public:
@@ -17,12 +19,14 @@ namespace lve
         BoxCollider(glm::vec3 position, glm::vec3 axis1, glm::vec3 axis2, glm::vec3 axis3);
 
         bool GetImpulse(ICollider* other, Collision& collision);
+        bool GetTimeOfImpact(glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time);
 
         bool CollidesWith(ICollider& other);
         float GetLengthAlongNormal(glm::vec3 normal) const;
         AABB GetAABB();
 
-        LveModel* GetWireFrame(LveDevice& device, glm::vec3 color);
+        // defined in box_collider_wireframe.cpp so the collision code can be built without a renderer
+        LveModel* GetWireFrame(LveDevice& device, glm::vec3 color) const;
 
     private:
         bool isSeparated(glm::vec3 distance, glm::vec3 normal, float width1, float width2);
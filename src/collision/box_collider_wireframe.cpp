@@ -0,0 +1,46 @@
+#include "box_collider.hpp"
+
+#include "../lve_model.hpp"
+
+namespace lve
+{
+    LveModel* BoxCollider::GetWireFrame(LveDevice& device, glm::vec3 color) const
+    {
+        LveModel::Builder builder;
+
+        builder.vertices.push_back({position + axes[0] + axes[1] + axes[2], color});
+        builder.vertices.push_back({position + axes[0] + axes[1] - axes[2], color});
+        builder.vertices.push_back({position + axes[0] - axes[1] + axes[2], color});
+        builder.vertices.push_back({position + axes[0] - axes[1] - axes[2], color});
+        builder.vertices.push_back({position - axes[0] + axes[1] + axes[2], color});
+        builder.vertices.push_back({position - axes[0] + axes[1] - axes[2], color});
+        builder.vertices.push_back({position - axes[0] - axes[1] + axes[2], color});
+        builder.vertices.push_back({position - axes[0] - axes[1] - axes[2], color});
+
+        builder.indices.push_back(0);
+        builder.indices.push_back(1);
+        builder.indices.push_back(2);
+
+        builder.indices.push_back(5);
+        builder.indices.push_back(6);
+        builder.indices.push_back(7);
+
+        builder.indices.push_back(0);
+        builder.indices.push_back(4);
+        builder.indices.push_back(5);
+
+        builder.indices.push_back(2);
+        builder.indices.push_back(3);
+        builder.indices.push_back(7);
+
+        builder.indices.push_back(2);
+        builder.indices.push_back(4);
+        builder.indices.push_back(6);
+
+        builder.indices.push_back(1);
+        builder.indices.push_back(3);
+        builder.indices.push_back(5);
+
+        return new LveModel(device, builder);
+    }
+}
\ No newline at end of file
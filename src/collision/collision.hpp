@@ -1,14 +1,21 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include "../lve_game_object.hpp"
 
 namespace lve
 {
+    class ICollider;
+
     struct Collision
     {
         glm::vec3 normal{};
         float depth{};
-        LveGameObject* gameObject;
+        // coefficient of restitution for the contact (0 = no bounce, 1 = perfectly elastic)
+        float restitution{};
+        // hole of the collider that was hit, or -1 if it's shared between holes
+        int courseIndex = -1;
+        // the static collider that produced this contact (see ICollider::colliderIndex). Used with courseIndex
+        // to match contacts between ticks
+        int colliderIndex = -1;
     };
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 #include "collision_manager.hpp"
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <fstream>
@@ -89,6 +90,16 @@ namespace lve
         staticColliders.push_back(collider);
     }
 
+    void CollisionManager::ClearStaticColliders()
+    {
+        for (ICollider* collider : staticColliders)
+        {
+            delete collider;
+        }
+        staticColliders.clear();
+        staticTree.Clear();
+    }
+
     void CollisionManager::buildStaticTree()
     {
         for (int i = 0; i < staticColliders.size(); i++)
@@ -106,22 +117,36 @@ namespace lve
     void CollisionManager::GetCollisions(ICollider& other, void (*OnCollision)(void*, Collision), void* context)
     {
         std::vector<int> colliderIndices;
-        staticTree.Retrieve(colliderIndices, other.GetAABB(), WORLDSIZE);
+        RetrieveCandidates(other.GetAABB(), colliderIndices);
 
         for (int i : colliderIndices)
         {
-            ICollider* ic = staticColliders[i];
-            if (ic->CollidesWith(other) && other.CollidesWith(*ic))
+            Collision collision{};
+            if (GetCollision(i, other, collision))
             {
-                Collision collision{};
-                if (ic->GetImpulse(&other, collision))
+                if (OnCollision != nullptr)
                 {
-                    if (OnCollision != nullptr)
-                    {
-                        OnCollision(context, collision);
-                    }
+                    OnCollision(context, collision);
                 }
             }
         }
     }
-}
\ No newline at end of file
+
+    void CollisionManager::RetrieveCandidates(const AABB& bounds, std::vector<int>& colliderIndices)
+    {
+        size_t first = colliderIndices.size();
+        staticTree.Retrieve(colliderIndices, bounds, WORLDSIZE);
+        std::sort(colliderIndices.begin() + first, colliderIndices.end());
+    }
+
+    bool CollisionManager::GetCollision(int colliderIndex, ICollider& other, Collision& collision)
+    {
+        ICollider* ic = staticColliders[colliderIndex];
+        return ic->CollidesWith(other) && other.CollidesWith(*ic) && ic->GetImpulse(&other, collision);
+    }
+
+    bool CollisionManager::GetTimeOfImpact(int colliderIndex, glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time)
+    {
+        return staticColliders[colliderIndex]->GetTimeOfImpact(start, velocity, acceleration, radius, maxTime, time);
+    }
+}
@@ -18,12 +18,22 @@ namespace lve
 
         static std::vector<BoxCollider> readCollidersFromFile(const std::string& filename);
 
+        // takes ownership of the collider
         void InsertStaticCollider(ICollider* collider);
+        // deletes every static collider and empties the tree, e.g. before rebuilding with a different set
+        void ClearStaticColliders();
         
         void buildStaticTree();
 
         void GetCollisions(ICollider& collider, void (*OnCollision)(void*, Collision), void* context);
 
+        // broadphase and narrowphase as separate steps, for callers that batch many queries together.
+        // RetrieveCandidates appends the indices of static colliders that might touch the given bounds, in
+        // ascending order, so the result doesn't depend on the shape of the tree
+        void RetrieveCandidates(const AABB& bounds, std::vector<int>& colliderIndices);
+        bool GetCollision(int colliderIndex, ICollider& collider, Collision& collision);
+        bool GetTimeOfImpact(int colliderIndex, glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time);
+
     private:
         static glm::vec3 readVec3(const std::string& line);
 
@@ -2,7 +2,6 @@
 
 #include "collision.hpp"
 #include "quad_tree.hpp"
-#include "../lve_game_object.hpp"
 #include <glm/glm.hpp>
 
 namespace lve
@@ -10,13 +9,23 @@ namespace lve
     class ICollider
     {
     public:
+        virtual ~ICollider() = default;
+
         virtual bool CollidesWith(ICollider& other) = 0;
         virtual float GetLengthAlongNormal(glm::vec3 normal) const = 0;
         virtual AABB GetAABB() = 0;
 
         virtual bool GetImpulse(ICollider* other, Collision& collision) = 0;
 
+        // earliest time in [0, maxTime] that a sphere moving along start + velocity*t + acceleration*t^2/2 could touch
+        // this collider. Allowed to be early but never late, so it's safe to jump straight to it
+        virtual bool GetTimeOfImpact(glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time) = 0;
+
         glm::vec3 position;
-        LveGameObject* gameObject = nullptr;
+        // which hole this collider belongs to, or -1 if it's shared between holes
+        int courseIndex = -1;
+        // position among its hole's colliders, or -1 for colliders that aren't part of the course. Together with
+        // courseIndex it names the same collider across world rebuilds, which its address doesn't
+        int colliderIndex = -1;
     };
 }
\ No newline at end of file
@@ -141,6 +141,11 @@ namespace lve
     }
 
     QuadTree::~QuadTree()
+    {
+        Clear();
+    }
+
+    void QuadTree::Clear()
     {
         if (children[0] != nullptr)
         {
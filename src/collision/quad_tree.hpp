@@ -24,6 +24,8 @@ namespace lve
         QuadTree();
         ~QuadTree();
         void Insert(const AABB rect, const AABB bounds);
+        // removes every box and collapses the tree back to a single node
+        void Clear();
         void Retrieve(std::vector<int>& colliders, const AABB rect, const AABB bounds);
 
         // for debugging the tree
@@ -1,4 +1,5 @@
 #include "sphere_collider.hpp"
+#include "box_collider.hpp"
 
 namespace lve
 {
@@ -31,4 +32,11 @@ namespace lve
     {
         return false;
     }
+
+    bool SphereCollider::GetTimeOfImpact(glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time)
+    {
+        // the cube around the sphere is a good enough bound, since it only has to be early
+        BoxCollider bounds{ position, glm::vec3{ this->radius, 0.0f, 0.0f }, glm::vec3{ 0.0f, this->radius, 0.0f }, glm::vec3{ 0.0f, 0.0f, this->radius } };
+        return bounds.GetTimeOfImpact(start, velocity, acceleration, radius, maxTime, time);
+    }
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace lve
         AABB GetAABB();
 
         bool GetImpulse(ICollider* other, Collision& collision);
+        bool GetTimeOfImpact(glm::vec3 start, glm::vec3 velocity, glm::vec3 acceleration, float radius, float maxTime, float& time);
         
         float radius;
     };
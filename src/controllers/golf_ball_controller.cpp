@@ -1,160 +1,148 @@
 #include "golf_ball_controller.hpp"
 
+#include <limits>
+
 namespace lve
 {
-    GolfBallController::GolfBallController(LveGameObject& gameObject, float radius)
-        : gameObject{ gameObject }, collider{gameObject.transform.translation, radius * gameObject.transform.scale.x}
+    static BallSimulation::Settings makeSettings(float radius)
+    {
+        BallSimulation::Settings settings{};
+        settings.radius = radius;
+        return settings;
+    }
+
+    GolfBallController::GolfBallController(LveScene& scene, LveScene::Entity ball, CourseWorld& world, float radius)
+        : scene{ scene }, ball{ ball }, simulation{ world, makeSettings(radius * scene.transforms.get(ball).getScale().x) }
     {
+        state.position = scene.transforms.get(ball).getTranslation();
+        state.previousPos = state.position;
     }
 
-    void GolfBallController::update(GLFWwindow* window, float dt)
+    TickInput GolfBallController::readInput(GLFWwindow* window, float dt)
     {
+        TickInput input{};
+        input.dt = dt;
         if (isAttached)
         {
-            glm::vec3 rotate{ 0 };
-            if (glfwGetKey(window, keys.lookRight) == GLFW_PRESS) rotate.y += 90.0f * dt;
-            if (glfwGetKey(window, keys.lookLeft) == GLFW_PRESS) rotate.y -= 90.0f * dt;
-
-            if (!moving)
-            {
-                if (aiming)
-                {
-                    if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) power += maxPower * dt;
-                    if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) power -= maxPower * dt;
-                    power = glm::clamp(power, 0.0f, maxPower);
-
-                    if (glfwGetKey(window, keys.launch) == GLFW_RELEASE)
-                    {
-                        aiming = false;
-                        float yaw = aimRotation.y;
-                        velocity = { sin(yaw), 0.0f, cos(yaw) };
-                        velocity = velocity * power;
-                        moving = true;
-                        power = 0.0f;
-                    }
-                }
-                else
-                {
-                    if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) rotate.x += 90.0f * dt;
-                    if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) rotate.x -= 90.0f * dt;
-
-                    if (glfwGetKey(window, keys.launch) == GLFW_PRESS)
-                    {
-                        aiming = true;
-                    }
-                }
-                if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
-                    aimRotation += lookSpeed * dt * glm::normalize(rotate);
-                }
-                aimRotation.x = glm::clamp(aimRotation.x, -1.5f, 1.5f);
-                aimRotation.y = glm::mod(aimRotation.y, glm::two_pi<float>());
-                return;
-            }
-            if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) rotate.x += 1.0f;
-            if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) rotate.x -= 1.0f;
-            if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
-                aimRotation += lookSpeed * dt * glm::normalize(rotate);
-            }
-            aimRotation.x = glm::clamp(aimRotation.x, -1.5f, 1.5f);
-            aimRotation.y = glm::mod(aimRotation.y, glm::two_pi<float>());
+            input.launch = updateInput(window, dt);
         }
+        input.aim = { aimRotation.x, aimRotation.y };
+        input.power = power;
+        input.aiming = aiming;
+        return input;
+    }
 
-        if (!moving)
-        {
-            return;
-        }
+    BallSimulation::StepResult GolfBallController::update(const TickInput& input)
+    {
+        aimRotation.x = input.aim.x;
+        aimRotation.y = input.aim.y;
+        power = input.power;
+        aiming = input.aiming;
 
-        if (bIsGrounded)
+        BallSimulation::StepResult result = simulation.tick(state, input);
+        if (input.launch)
         {
-            glm::vec3 loss = glm::normalize(velocity);
-            velocity = velocity - ((loss * drag + velocity * friction) * dt);
-            bIsGrounded = false;
+            aiming = false;
+            power = 0.0f;
         }
-        velocity.y += gravity * dt;
-        glm::vec3 movement = {velocity.x, velocity.y, velocity.z};
-
-        gameObject.transform.translation += movement * dt;
-    }
 
-    SphereCollider& GolfBallController::getCollider()
-    {
-        collider.position = gameObject.transform.translation;
-        return collider;
+        scene.transforms.get(ball).setTranslation(state.position);
+        return result;
     }
 
-    void GolfBallController::onCollision(const Collision& collision)
+    bool GolfBallController::updateInput(GLFWwindow* window, float dt)
     {
-        gameObject.transform.translation += (collision.normal * collision.depth);
-        collider.position = gameObject.transform.translation;
+        bool launch = false;
+        glm::vec3 rotate{ 0 };
+        if (glfwGetKey(window, keys.lookRight) == GLFW_PRESS) rotate.y += 90.0f * dt;
+        if (glfwGetKey(window, keys.lookLeft) == GLFW_PRESS) rotate.y -= 90.0f * dt;
 
-        float impulse;
-        // the collision struct could use a value to 'dampen' the object's energy on impact
-        // for now, since all floors should be soft, I'm just doing it manually
-        if (collision.normal.y <= -0.6f)
+        if (!state.moving)
         {
-            impulse = glm::dot(velocity, collision.normal) * 1.55f;
-        }
-        else
-        {
-            impulse = glm::dot(velocity, collision.normal) * 1.95f;
-        }
-        velocity = velocity - (collision.normal * impulse);
-
-        if (collision.normal.y <= -0.99)
-        {
-            bIsGrounded = true;
-
-            if (glm::dot(velocity, velocity) < 0.005)
+            if (aiming)
             {
-                moving = false;
+                if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) power += maxPower * dt;
+                if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) power -= maxPower * dt;
+                power = glm::clamp(power, 0.0f, maxPower);
 
-                if (collision.gameObject != nullptr && collision.gameObject->tag != courseIds[currentCourse])
+                if (glfwGetKey(window, keys.launch) == GLFW_RELEASE)
                 {
-                    resetBall();
+                    aiming = false;
+                    launch = true;
                 }
-                else
+            }
+            else
+            {
+                if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) rotate.x += 90.0f * dt;
+                if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) rotate.x -= 90.0f * dt;
+
+                if (glfwGetKey(window, keys.launch) == GLFW_PRESS)
                 {
-                    previousPos = gameObject.transform.translation;
+                    aiming = true;
                 }
             }
+            if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
+                aimRotation += lookSpeed * dt * glm::normalize(rotate);
+            }
+            aimRotation.x = glm::clamp(aimRotation.x, -1.5f, 1.5f);
+            aimRotation.y = glm::mod(aimRotation.y, glm::two_pi<float>());
+            return launch;
         }
+        if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) rotate.x += 1.0f;
+        if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) rotate.x -= 1.0f;
+        if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
+            aimRotation += lookSpeed * dt * glm::normalize(rotate);
+        }
+        aimRotation.x = glm::clamp(aimRotation.x, -1.5f, 1.5f);
+        aimRotation.y = glm::mod(aimRotation.y, glm::two_pi<float>());
+        return launch;
     }
 
-    bool GolfBallController::showReticle()
+    void GolfBallController::resetState(const glm::vec3& position, int course)
     {
-        return aiming;
+        state = BallState{};
+        state.position = position;
+        state.previousPos = position;
+        state.currentCourse = course;
+        simulation.resetContactCache();
+
+        scene.transforms.get(ball).setTranslation(state.position);
     }
 
-    float GolfBallController::getPowerRatio()
+    void GolfBallController::saveSnapshot(WorldSnapshot& snapshot) const
     {
-        return power / maxPower;
+        snapshot.ball = state;
+        simulation.saveContactCache(snapshot.contactCache);
+        snapshot.aimRotation = aimRotation;
+        snapshot.power = power;
+        snapshot.aiming = aiming;
+        snapshot.attached = isAttached;
     }
 
-    void GolfBallController::resetBall(glm::vec3 position)
+    void GolfBallController::restoreSnapshot(const WorldSnapshot& snapshot)
     {
-        moving = false;
-        bIsGrounded = true;
-        velocity = { 0.0f, 0.0f, 0.0f };
-        gameObject.transform.translation = position;
-        previousPos = position;
+        state = snapshot.ball;
+        simulation.restoreContactCache(snapshot.contactCache);
+        aimRotation = snapshot.aimRotation;
+        power = snapshot.power;
+        aiming = snapshot.aiming;
+        isAttached = snapshot.attached;
+
+        scene.transforms.get(ball).setTranslation(state.position);
     }
 
-    void GolfBallController::resetBall()
+    bool GolfBallController::showReticle()
     {
-        moving = false;
-        bIsGrounded = true;
-        velocity = { 0.0f, 0.0f, 0.0f };
-        gameObject.transform.translation = previousPos;
+        return aiming;
     }
 
-    bool GolfBallController::isMoving()
+    float GolfBallController::getPowerRatio()
     {
-        return moving;
+        return power / maxPower;
     }
 
-    void GolfBallController::nextHole(glm::vec3 position)
+    bool GolfBallController::isMoving()
     {
-        resetBall(position);
-        currentCourse = (currentCourse + 1) % courseIds.size();
+        return state.moving;
     }
-}
\ No newline at end of file
+}
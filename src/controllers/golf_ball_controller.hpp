@@ -1,16 +1,17 @@
 #pragma once
 
-#include "../lve_game_object.hpp"
+#include "../lve_scene.hpp"
 #include "../lve_window.hpp"
-#include "../collision/collision.hpp"
-#include "../collision/sphere_collider.hpp"
+#include "../physics/ball_simulation.hpp"
+#include "../physics/course_world.hpp"
+#include "../physics/world_snapshot.hpp"
 
 #include <glm/glm.hpp>
-#include <string>
-#include <vector>
 
 namespace lve
 {
+    // GLFW input adapter for the ball simulation. Turns key presses into aiming and shots,
+    // steps the simulation and copies the result onto the ball's game object
     class GolfBallController
     {
     public:
@@ -22,48 +23,53 @@ namespace lve
             int launch = GLFW_KEY_SPACE;
 		};
 
-        GolfBallController(LveGameObject& gameObject, float radius);
+        GolfBallController(LveScene& scene, LveScene::Entity ball, CourseWorld& world, float radius);
 
-        void update(GLFWwindow* window, float dt);
-
-        SphereCollider& getCollider();
-        void onCollision(const Collision& collision);
-        static void ForwardOnCollision(void* context, Collision collision)
-        {
-            static_cast<GolfBallController*>(context)->onCollision(collision);
-        }
+        // reads this tick's aiming, power and launch from the keyboard
+        TickInput readInput(GLFWwindow* window, float dt);
+        // applies a tick of input, live or recorded, and steps the ball
+        BallSimulation::StepResult update(const TickInput& input);
+        BallSimulation::StepResult update(GLFWwindow* window, float dt) { return update(readInput(window, dt)); }
 
         bool showReticle();
         float getPowerRatio();
+        float getMaxPower() { return maxPower; }
+        // the shot that would be taken if the player let go right now
+        ShotCommand getAimedShot() { return ShotCommand{ aimRotation.y, 0.0f, power }; }
+        const BallSimulation::Settings& getSimulationSettings() { return simulation.getSettings(); }
 
-        void resetBall();
-        void resetBall(glm::vec3 position);
-        void nextHole(glm::vec3 position);
         bool isMoving();
+        // a sleeping ball needs no collision queries until it is launched or reset
+        bool isSleeping() { return state.sleep.asleep; }
+        SleepState& getSleepState() { return state.sleep; }
+        glm::vec3 getVelocity() { return state.velocity; }
+        int getCurrentCourse() { return state.currentCourse; }
+        const BallState& getState() { return state; }
+
+        // puts the ball at rest at position on the given hole, e.g. where a recording starts
+        void resetState(const glm::vec3& position, int course);
+        // copies everything the ball and its controls need to carry on from this tick
+        void saveSnapshot(WorldSnapshot& snapshot) const;
+        void restoreSnapshot(const WorldSnapshot& snapshot);
         
-        LveGameObject& gameObject;
+        LveScene& scene;
+        LveScene::Entity ball;
         // horizontal rotation for where the player is aiming
         glm::vec3 aimRotation{-1.0f, -1.5f, 0.0f};
 
         bool isAttached = true;
     private:
+        // returns true if the player let go of the swing this tick
+        bool updateInput(GLFWwindow* window, float dt);
+
         KeyMappings keys{};
-		glm::vec3 velocity{ 0.0f };
         float power{ 0.0f };
         float maxPower{ 10.0f };
 		float lookSpeed{ 1.5f };
-        float gravity{ 14.7f };
-        float friction{ 0.6f };
-        float drag{ 0.1f };
 
-        bool moving = false;
         bool aiming = false;
-        bool bIsGrounded = false;
-
-        std::vector<std::string> courseIds = {"c1", "c2", "c3", "c4", "c5", "c6", "c7", "c8", "c9"};
-        int currentCourse = 0;
-        glm::vec3 previousPos{0.0f};
 
-        SphereCollider collider;
+        BallState state{};
+        BallSimulation simulation;
     };
-}
\ No newline at end of file
+}
@@ -13,14 +13,16 @@ namespace lve
 		if (glfwGetKey(window, keys.lookUp) == GLFW_PRESS) rotate.x += 1.0f;
 		if (glfwGetKey(window, keys.lookDown) == GLFW_PRESS) rotate.x -= 1.0f;
 
+		glm::vec3 rotation = gameObject.transform.getRotation();
 		if (glm::dot(rotate, rotate) > std::numeric_limits<float>::epsilon()) {
-			gameObject.transform.rotation += lookSpeed * dt * glm::normalize(rotate);
+			rotation += lookSpeed * dt * glm::normalize(rotate);
 		}
 
-		gameObject.transform.rotation.x = glm::clamp(gameObject.transform.rotation.x, -1.5f, 1.5f);
-		gameObject.transform.rotation.y = glm::mod(gameObject.transform.rotation.y, glm::two_pi<float>());
+		rotation.x = glm::clamp(rotation.x, -1.5f, 1.5f);
+		rotation.y = glm::mod(rotation.y, glm::two_pi<float>());
+		gameObject.transform.setRotation(rotation);
 
-		float yaw = gameObject.transform.rotation.y;
+		float yaw = rotation.y;
 		const glm::vec3 forwardDir{ sin(yaw), 0.0f, cos(yaw) };
 		const glm::vec3 rightDir{ forwardDir.z, 0.0f, -forwardDir.x };
 		const glm::vec3 upDir{ 0.0f, -1.0f, 0.0f };
@@ -34,7 +36,7 @@ namespace lve
 		if (glfwGetKey(window, keys.moveDown) == GLFW_PRESS) moveDir -= upDir;
 
 		if (glm::dot(moveDir, moveDir) > std::numeric_limits<float>::epsilon()) {
-			gameObject.transform.translation += moveSpeed * dt * glm::normalize(moveDir);
+			gameObject.transform.setTranslation(gameObject.transform.getTranslation() + moveSpeed * dt * glm::normalize(moveDir));
 		}
 	}
 } // namespace lve
\ No newline at end of file
@@ -0,0 +1,255 @@
+// Headless entry point: runs the ball physics against the course colliders with no window, GPU or display.
+// Meant for server-side simulation and automated physics checks.
+//
+// usage: headless [shots per hole] [power] [step|event]
+//        headless replay <recording> [--max-speed] [--rollback ticks]
+//        headless compile-scene <scene> <compiled scene>
+#include "physics/ball_simulation.hpp"
+#include "physics/course_world.hpp"
+#include "physics/round_recording.hpp"
+#include "lve_scene_description.hpp"
+
+// libs
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+    constexpr float TIMESTEP = 1.0f / 120.0f;
+    constexpr float MAX_SHOT_TIME = 30.0f;
+
+    struct ShotOutcome
+    {
+        lve::BallState finalState;
+        float time;
+        bool holed;
+        bool reset;
+    };
+
+    // simulates one shot from the start state until the ball stops, falls off the course or runs out of time
+    ShotOutcome simulateShot(lve::BallSimulation& simulation, lve::BallState state, const lve::ShotCommand& shot, bool eventDriven)
+    {
+        ShotOutcome outcome{};
+        simulation.launch(state, shot);
+
+        float time = 0.0f;
+        while (time < MAX_SHOT_TIME)
+        {
+            float elapsed = TIMESTEP;
+            lve::BallSimulation::StepResult result = eventDriven
+                ? simulation.advance(state, TIMESTEP, MAX_SHOT_TIME - time, elapsed)
+                : simulation.step(state, TIMESTEP);
+            time += elapsed;
+
+            if (result.holed || result.reset || result.stopped)
+            {
+                outcome.holed = result.holed;
+                outcome.reset = result.reset;
+                break;
+            }
+        }
+
+        outcome.finalState = state;
+        outcome.time = time;
+        return outcome;
+    }
+
+    // re-simulates a recorded round and checks it ends where the recording did. Paced to the recorded
+    // tick lengths unless maxSpeed is set, in which case it runs as fast as it can.
+    // With rollbackTicks set, it also rewinds that many ticks once a second and resimulates them, the way
+    // networked play would after a late input, and checks it lands exactly where it was
+    int replayRound(const std::string& filename, bool maxSpeed, uint32_t rollbackTicks)
+    {
+        lve::CourseWorld world{};
+        world.loadDefaultCourse();
+
+        lve::RoundRecording recording = lve::RoundRecording::load(filename);
+        lve::RoundReplay replay{world, recording};
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        float simulatedTime = 0.0f;
+        int shots = 0;
+        int holes = 0;
+
+        lve::SnapshotRing history{ rollbackTicks + 1 };
+        int rollbacks = 0;
+        int rollbackMismatches = 0;
+        float rollbackTime = 0.0f;
+
+        while (!replay.isDone())
+        {
+            if (rollbackTicks > 0)
+            {
+                uint32_t now = static_cast<uint32_t>(replay.getTick());
+                if (now % 60 == 0 && now >= rollbackTicks)
+                {
+                    auto rollbackStart = std::chrono::high_resolution_clock::now();
+                    uint64_t expected = lve::hashBallState(replay.getState());
+
+                    uint32_t target = now - rollbackTicks;
+                    replay.restoreSnapshot(*history.find(target));
+                    history.discardFrom(target);
+                    while (replay.getTick() < now)
+                    {
+                        replay.saveSnapshot(history.save(static_cast<uint32_t>(replay.getTick())));
+                        replay.tick();
+                    }
+
+                    rollbackTime += std::chrono::duration<float, std::chrono::microseconds::period>(
+                        std::chrono::high_resolution_clock::now() - rollbackStart).count();
+                    rollbacks++;
+                    if (lve::hashBallState(replay.getState()) != expected)
+                    {
+                        rollbackMismatches++;
+                    }
+                }
+                replay.saveSnapshot(history.save(now));
+            }
+
+            const lve::TickInput& input = recording.ticks[replay.getTick()];
+            if (input.launch)
+            {
+                shots++;
+            }
+
+            lve::BallSimulation::StepResult result = replay.tick();
+            simulatedTime += input.dt;
+            if (result.holed)
+            {
+                holes++;
+            }
+
+            if (!maxSpeed)
+            {
+                // a float time point can't hold today's clock values to better than minutes, so convert first
+                std::this_thread::sleep_until(startTime + std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                    std::chrono::duration<double>(simulatedTime)));
+            }
+        }
+
+        float elapsed = std::chrono::duration<float, std::chrono::milliseconds::period>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        bool matches = lve::hashBallState(replay.getState()) == recording.finalStateHash;
+
+        std::cout << replay.getTick() << " ticks (" << simulatedTime << " s of play, seed " << recording.seed << ") replayed in "
+            << elapsed << " ms: " << shots << " shots, " << holes << " holes\n";
+        std::cout << "final state " << (matches ? "matches" : "DOES NOT match") << " the recording\n";
+        if (rollbacks > 0)
+        {
+            std::cout << rollbacks << " rollbacks of " << rollbackTicks << " ticks, " << rollbackTime / rollbacks << " us each, "
+                << rollbackMismatches << " diverged\n";
+        }
+        return (matches && rollbackMismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // turns a text scene into the compiled form, which loads without any parsing
+    if (argc > 3 && std::string(argv[1]) == "compile-scene")
+    {
+        try {
+            lve::SceneDescription::load(argv[2]).save(argv[3]);
+            return EXIT_SUCCESS;
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "replay")
+    {
+        try {
+            bool maxSpeed = false;
+            uint32_t rollbackTicks = 0;
+            for (int i = 3; i < argc; i++)
+            {
+                std::string flag = argv[i];
+                if (flag == "--max-speed")
+                {
+                    maxSpeed = true;
+                }
+                else if (flag == "--rollback" && i + 1 < argc)
+                {
+                    rollbackTicks = static_cast<uint32_t>(std::stoul(argv[++i]));
+                }
+            }
+            return replayRound(argv[2], maxSpeed, rollbackTicks);
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << '\n';
+            return EXIT_FAILURE;
+        }
+    }
+
+    int shotsPerHole = argc > 1 ? std::atoi(argv[1]) : 16;
+    float power = argc > 2 ? std::stof(argv[2]) : 6.0f;
+    // event mode skips through the ball's flights analytically instead of stepping them
+    bool eventDriven = argc > 3 && std::string(argv[3]) == "event";
+
+    try {
+        lve::CourseWorld world{};
+        world.loadDefaultCourse();
+
+        lve::BallSimulation simulation{world};
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        int totalShots = 0;
+
+        for (int hole = 0; hole < world.getHoleCount(); hole++)
+        {
+            lve::BallState tee{};
+            tee.currentCourse = hole;
+            tee.position = world.tees[hole];
+            tee.previousPos = world.tees[hole];
+
+            int holed = 0;
+            int resets = 0;
+            float closest = std::numeric_limits<float>::max();
+            for (int i = 0; i < shotsPerHole; i++)
+            {
+                float yaw = glm::two_pi<float>() * i / shotsPerHole;
+                ShotOutcome outcome = simulateShot(simulation, tee, lve::ShotCommand{ yaw, 0.0f, power }, eventDriven);
+                totalShots++;
+
+                if (outcome.holed)
+                {
+                    holed++;
+                }
+                else if (outcome.reset)
+                {
+                    resets++;
+                }
+                else
+                {
+                    glm::vec3 toGoal = world.goals[hole].position - outcome.finalState.position;
+                    closest = std::min(closest, glm::length(glm::vec3{ toGoal.x, 0.0f, toGoal.z }));
+                }
+            }
+
+            std::cout << "hole " << hole + 1 << ": " << holed << " holed, " << resets << " reset";
+            if (closest < std::numeric_limits<float>::max())
+            {
+                std::cout << ", closest stop " << closest << " from the goal";
+            }
+            std::cout << '\n';
+        }
+
+        float elapsed = std::chrono::duration<float, std::chrono::milliseconds::period>(
+            std::chrono::high_resolution_clock::now() - startTime).count();
+        std::cout << totalShots << " shots simulated in " << elapsed << " ms\n";
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
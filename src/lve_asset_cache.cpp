@@ -0,0 +1,162 @@
+#include "lve_asset_cache.hpp"
+
+// std
+#include <filesystem>
+#include <system_error>
+
+namespace lve
+{
+	LveAssetCache::LveAssetCache(LveDevice& device, LveThreadPool& threadPool)
+		: device{ device }, threadPool{ threadPool } {}
+
+	std::string LveAssetCache::canonicalPath(const std::string& path)
+	{
+		std::error_code error;
+		std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+		if (error)
+		{
+			// still better than nothing for telling paths apart, and the load reports the real problem
+			return std::filesystem::path{ path }.lexically_normal().generic_string();
+		}
+		return canonical.generic_string();
+	}
+
+	LveAssetCache::PendingModel LveAssetCache::startParse(const std::string& key, Entry& entry)
+	{
+		// the task only holds the path, so it's fine for the cache to go away while it runs
+		entry.parsing = threadPool.submit([key]() {
+			auto parsed = std::make_shared<ParsedMesh>();
+			if (LveMeshCache::load(key, parsed->cached))
+			{
+				parsed->vertices = parsed->cached.vertices;
+				parsed->vertexCount = parsed->cached.vertexCount;
+				parsed->indices = parsed->cached.indices;
+				parsed->indexCount = parsed->cached.indexCount;
+			}
+			else
+			{
+				parsed->builder.loadModel(key);
+				parsed->vertices = parsed->builder.vertices.data();
+				parsed->vertexCount = static_cast<uint32_t>(parsed->builder.vertices.size());
+				parsed->indices = parsed->builder.indices.data();
+				parsed->indexCount = static_cast<uint32_t>(parsed->builder.indices.size());
+			}
+			return std::shared_ptr<const ParsedMesh>{ std::move(parsed) };
+		}).share();
+		return entry.parsing;
+	}
+
+	LveAssetCache::PendingModel LveAssetCache::prefetch(const std::string& path)
+	{
+		std::string key = canonicalPath(path);
+		std::lock_guard<std::mutex> lock{ mutex };
+		Entry& entry = entries[key];
+		if (!entry.model.expired()) return {};
+		entry.prefetches++;
+		if (entry.parsing.valid()) return entry.parsing;
+		return startParse(key, entry);
+	}
+
+	void LveAssetCache::cancelPrefetch(const std::string& path)
+	{
+		std::string key = canonicalPath(path);
+		std::lock_guard<std::mutex> lock{ mutex };
+		auto entry = entries.find(key);
+		if (entry == entries.end()) return;
+		if (entry->second.prefetches > 0) entry->second.prefetches--;
+		if (entry->second.prefetches == 0 && entry->second.model.expired())
+		{
+			entries.erase(entry);
+		}
+	}
+
+	void LveAssetCache::collectGarbage()
+	{
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (auto entry = entries.begin(); entry != entries.end();)
+		{
+			if (entry->second.model.expired() && !entry->second.parsing.valid())
+			{
+				entry = entries.erase(entry);
+			}
+			else
+			{
+				++entry;
+			}
+		}
+	}
+
+	std::shared_ptr<LveModel> LveAssetCache::getModel(const std::string& path, LveUploadBatch* uploads)
+	{
+		std::string key = canonicalPath(path);
+		PendingModel parsing;
+		{
+			std::lock_guard<std::mutex> lock{ mutex };
+			Entry& entry = entries[key];
+			if (std::shared_ptr<LveModel> model = entry.model.lock()) return model;
+			parsing = entry.parsing.valid() ? entry.parsing : startParse(key, entry);
+		}
+
+		// outside the lock, so other requests aren't held up by the parse
+		std::shared_ptr<const ParsedMesh> parsed;
+		try
+		{
+			parsed = threadPool.wait(parsing);
+		}
+		catch (...)
+		{
+			// let the next request try again, in case the file gets fixed
+			std::lock_guard<std::mutex> lock{ mutex };
+			auto entry = entries.find(key);
+			if (entry != entries.end() && entry->second.model.expired()) entries.erase(entry);
+			throw;
+		}
+
+		// also outside the lock: without a batch, creating the buffers waits for the upload. Only the device's
+		// thread calls getModel, so no one else can be creating the same model meanwhile
+		std::shared_ptr<LveModel> model = std::make_shared<LveModel>(
+			device, parsed->vertices, parsed->vertexCount, parsed->indices, parsed->indexCount, uploads);
+
+		std::lock_guard<std::mutex> lock{ mutex };
+		Entry& entry = entries[key];
+		entry.model = model;
+		entry.bytes = model->getMemorySize();
+		// the CPU copy isn't needed once the buffers exist, and that answers every prefetch
+		entry.parsing = {};
+		entry.prefetches = 0;
+		return model;
+	}
+
+	std::shared_ptr<LveModel> LveAssetCache::findModel(const std::string& path) const
+	{
+		std::string key = canonicalPath(path);
+		std::lock_guard<std::mutex> lock{ mutex };
+		auto entry = entries.find(key);
+		return entry != entries.end() ? entry->second.model.lock() : nullptr;
+	}
+
+	std::vector<LveAssetCache::AssetInfo> LveAssetCache::getResidentAssets() const
+	{
+		std::vector<AssetInfo> assets{};
+		std::lock_guard<std::mutex> lock{ mutex };
+		for (const auto& [path, entry] : entries)
+		{
+			long references = entry.model.use_count();
+			if (references > 0)
+			{
+				assets.push_back(AssetInfo{ path, entry.bytes, references });
+			}
+		}
+		return assets;
+	}
+
+	VkDeviceSize LveAssetCache::getResidentBytes() const
+	{
+		VkDeviceSize bytes = 0;
+		for (const AssetInfo& asset : getResidentAssets())
+		{
+			bytes += asset.bytes;
+		}
+		return bytes;
+	}
+} // namespace lve
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "lve_device.hpp"
+#include "lve_mesh_cache.hpp"
+#include "lve_model.hpp"
+#include "lve_thread_pool.hpp"
+#include "lve_upload_batch.hpp"
+
+// std
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lve
+{
+	// Shared models keyed by canonical path, so any number of objects, scenes or holes asking for the same file
+	// share one set of GPU buffers.
+	// The cache only holds weak references: a model is freed (buffers and all) as soon as the last shared_ptr to
+	// it goes, and is loaded again the next time something asks for it. Requests for a file that's already being
+	// parsed wait on that parse instead of starting another one, whichever thread they come from
+	class LveAssetCache
+	{
+	public:
+		// a file read on the thread pool: the mapped mesh cache file when there's an up to date one, so it goes
+		// from the mapping straight into staging memory, otherwise the freshly parsed OBJ
+		struct ParsedMesh
+		{
+			LveMeshCache::Mesh cached;
+			LveModel::Builder builder;
+			// whichever of the two holds the mesh
+			const LveModel::Vertex* vertices = nullptr;
+			uint32_t vertexCount = 0;
+			const uint32_t* indices = nullptr;
+			uint32_t indexCount = 0;
+		};
+
+		// a parse on the thread pool. Invalid when the model was already resident
+		using PendingModel = std::shared_future<std::shared_ptr<const ParsedMesh>>;
+
+		struct AssetInfo
+		{
+			std::string path;
+			// vertex and index data on the GPU
+			VkDeviceSize bytes;
+			// shared_ptrs to the model outside the cache
+			long references;
+		};
+
+		explicit LveAssetCache(LveDevice& device, LveThreadPool& threadPool = LveThreadPool::global());
+
+		LveAssetCache(const LveAssetCache&) = delete;
+		LveAssetCache& operator=(const LveAssetCache&) = delete;
+
+		// the key a path is cached under: absolute, with . and .. and symlinks resolved as far as the file exists
+		static std::string canonicalPath(const std::string& path);
+
+		// starts parsing the file on the thread pool unless it's resident or already being parsed. Safe from any
+		// thread, including pool tasks, which can wait on the result to know when getModel won't have to parse.
+		// The parsed mesh is held until getModel turns it into a model, or until every prefetch that returned a
+		// valid result has been cancelled
+		PendingModel prefetch(const std::string& path);
+		// for a prefetch that's no longer going to be followed by getModel. Once no prefetch of the file is left,
+		// its parsed mesh is dropped (a parse still running finishes, but nothing keeps its result)
+		void cancelPrefetch(const std::string& path);
+		// the model for the file, parsing it (or waiting for a prefetch) and creating its buffers if it isn't
+		// resident. Creates GPU buffers, so it belongs on the thread that owns the device's queue. With uploads,
+		// a newly created model can't be drawn until uploads has been waited on. Rethrows parse errors
+		std::shared_ptr<LveModel> getModel(const std::string& path, LveUploadBatch* uploads = nullptr);
+		// null unless the model is resident. Never loads anything
+		std::shared_ptr<LveModel> findModel(const std::string& path) const;
+
+		std::vector<AssetInfo> getResidentAssets() const;
+		VkDeviceSize getResidentBytes() const;
+
+		// forgets files whose model has been freed and that have nothing pending, so the cache only grows with
+		// what's in use
+		void collectGarbage();
+
+	private:
+		struct Entry
+		{
+			std::weak_ptr<LveModel> model;
+			VkDeviceSize bytes = 0;
+			// only kept between the parse starting and the model being created
+			PendingModel parsing;
+			// prefetches still waiting for getModel
+			int prefetches = 0;
+		};
+
+		// with the mutex held
+		PendingModel startParse(const std::string& key, Entry& entry);
+
+		LveDevice& device;
+		LveThreadPool& threadPool;
+
+		mutable std::mutex mutex;
+		std::unordered_map<std::string, Entry> entries;
+	};
+} // namespace lve
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "lve_frustum.hpp"
+
 // libs
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -24,6 +26,8 @@ namespace lve
 		const glm::mat4& getProjection() const { return projectionMatrix; }
 		const glm::mat4& getView() const { return viewMatrix; }
 		const glm::mat4& getInverseView() const { return inverseViewMatrix; }
+		// world space view volume for the current projection and view
+		LveFrustum getFrustum() const { return LveFrustum::fromMatrix(projectionMatrix * viewMatrix); }
 
 	private:
 		glm::mat4 projectionMatrix{ 1.0f };
@@ -1,7 +1,8 @@
 #pragma once
 
 #include "lve_camera.hpp"
-#include "lve_game_object.hpp"
+#include "lve_render_queue.hpp"
+#include "lve_scene.hpp"
 
 // lib
 #include <vulkan/vulkan.h>
@@ -31,6 +32,8 @@ namespace lve
 		VkCommandBuffer commandBuffer;
 		LveCamera& camera;
 		VkDescriptorSet globalDescriptorSet;
-		LveGameObject::Map& gameObjects;
+		LveScene& scene;
+		// sorted draws for the mesh passes, built from what survived culling this frame
+		const LveRenderQueue& renderQueue;
 	};
 } // namespace lve
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "lve_frustum.hpp"
+
+namespace lve
+{
+	LveFrustum LveFrustum::fromMatrix(const glm::mat4& projectionView)
+	{
+		// rows of the matrix (glm is column major)
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++)
+		{
+			rows[i] = glm::vec4{ projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i] };
+		}
+
+		LveFrustum frustum{};
+		frustum.planes[0] = rows[3] + rows[0]; // left
+		frustum.planes[1] = rows[3] - rows[0]; // right
+		frustum.planes[2] = rows[3] + rows[1]; // top or bottom, depending on the y flip
+		frustum.planes[3] = rows[3] - rows[1];
+		frustum.planes[4] = rows[2];           // near, since depth runs from 0 rather than -w
+		frustum.planes[5] = rows[3] - rows[2]; // far
+
+		// normalized, so the distance to a plane can be compared against a radius
+		for (glm::vec4& plane : frustum.planes)
+		{
+			plane /= glm::length(glm::vec3{ plane });
+		}
+		return frustum;
+	}
+
+	bool LveFrustum::intersectsSphere(const glm::vec3& center, float radius) const
+	{
+		for (const glm::vec4& plane : planes)
+		{
+			if (glm::dot(glm::vec3{ plane }, center) + plane.w < -radius) return false;
+		}
+		return true;
+	}
+
+	bool LveFrustum::containsSphere(const glm::vec3& center, float radius) const
+	{
+		for (const glm::vec4& plane : planes)
+		{
+			if (glm::dot(glm::vec3{ plane }, center) + plane.w < radius) return false;
+		}
+		return true;
+	}
+
+	bool LveFrustum::intersectsBox(const glm::vec3& min, const glm::vec3& max) const
+	{
+		for (const glm::vec4& plane : planes)
+		{
+			// the corner furthest along the plane's normal. If even that one is outside, the whole box is
+			glm::vec3 corner{
+				plane.x >= 0.0f ? max.x : min.x,
+				plane.y >= 0.0f ? max.y : min.y,
+				plane.z >= 0.0f ? max.z : min.z };
+			if (glm::dot(glm::vec3{ plane }, corner) + plane.w < 0.0f) return false;
+		}
+		return true;
+	}
+
+	LveFrustum::Containment LveFrustum::classifyBox(const glm::vec3& min, const glm::vec3& max) const
+	{
+		Containment result = Containment::INSIDE;
+		for (const glm::vec4& plane : planes)
+		{
+			glm::vec3 normal{ plane };
+			glm::vec3 furthest{ normal.x >= 0.0f ? max.x : min.x, normal.y >= 0.0f ? max.y : min.y, normal.z >= 0.0f ? max.z : min.z };
+			if (glm::dot(normal, furthest) + plane.w < 0.0f) return Containment::OUTSIDE;
+
+			glm::vec3 nearest{ normal.x >= 0.0f ? min.x : max.x, normal.y >= 0.0f ? min.y : max.y, normal.z >= 0.0f ? min.z : max.z };
+			if (glm::dot(normal, nearest) + plane.w < 0.0f) result = Containment::INTERSECTS;
+		}
+		return result;
+	}
+} // namespace lve
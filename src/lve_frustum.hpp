@@ -0,0 +1,39 @@
+#pragma once
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <array>
+
+namespace lve
+{
+	// The six planes of a view volume, pulled out of a projection * view matrix (so they're in world space).
+	// Each plane is (normal, d) with the normal pointing into the volume, so a point is inside a plane when
+	// dot(normal, p) + d >= 0. Assumes the zero to one depth range the rest of the engine uses
+	class LveFrustum
+	{
+	public:
+		enum class Containment
+		{
+			OUTSIDE,
+			INTERSECTS,
+			INSIDE,
+		};
+
+		static LveFrustum fromMatrix(const glm::mat4& projectionView);
+
+		// conservative: these can say a shape is visible when it's just outside a corner, never the other way round
+		bool intersectsSphere(const glm::vec3& center, float radius) const;
+		bool intersectsBox(const glm::vec3& min, const glm::vec3& max) const;
+		// true if the sphere is entirely inside, in which case there's no point testing a tighter shape
+		bool containsSphere(const glm::vec3& center, float radius) const;
+		// INSIDE means everything in the box is inside too, so a hierarchy can stop testing below it
+		Containment classifyBox(const glm::vec3& min, const glm::vec3& max) const;
+
+	private:
+		std::array<glm::vec4, 6> planes{};
+	};
+} // namespace lve
@@ -2,14 +2,26 @@
 
 namespace lve
 {
-	glm::mat4 TransformComponent::mat4() {
+	const glm::mat4& TransformComponent::mat4()
+	{
+		if (dirty) updateMatrices();
+		return cachedMatrix;
+	}
+
+	const glm::mat3& TransformComponent::normalMatrix()
+	{
+		if (dirty) updateMatrices();
+		return cachedNormalMatrix;
+	}
+
+	void TransformComponent::updateMatrices() {
 		const float c3 = glm::cos(rotation.z);
 		const float s3 = glm::sin(rotation.z);
 		const float c2 = glm::cos(rotation.x);
 		const float s2 = glm::sin(rotation.x);
 		const float c1 = glm::cos(rotation.y);
 		const float s1 = glm::sin(rotation.y);
-		return glm::mat4{
+		cachedMatrix = glm::mat4{
 			{
 				scale.x * (c1 * c3 + s1 * s2 * s3),
 				scale.x * (c2 * s3),
@@ -29,19 +41,10 @@ namespace lve
 				0.0f,
 			},
 			{translation.x, translation.y, translation.z, 1.0f} };
-	}
 
-	glm::mat3 TransformComponent::normalMatrix()
-	{
-		const float c3 = glm::cos(rotation.z);
-		const float s3 = glm::sin(rotation.z);
-		const float c2 = glm::cos(rotation.x);
-		const float s2 = glm::sin(rotation.x);
-		const float c1 = glm::cos(rotation.y);
-		const float s1 = glm::sin(rotation.y);
+		// same rotation, inverse scale
 		const glm::vec3 invScale = 1.0f / scale;
-
-		return glm::mat3{
+		cachedNormalMatrix = glm::mat3{
 			{
 				invScale.x * (c1 * c3 + s1 * s2 * s3),
 				invScale.x * (c2 * s3),
@@ -58,6 +61,8 @@ namespace lve
 				invScale.z * (c1 * c2)
 			},
 		};
+
+		dirty = false;
 	}
 
 	LveGameObject LveGameObject::makePointLight(
@@ -65,7 +70,7 @@ namespace lve
 	{
 		LveGameObject gameObj = LveGameObject::createGameObject();
 		gameObj.color = color;
-		gameObj.transform.scale.x = radius;
+		gameObj.transform.setScale({ radius, 1.0f, 1.0f });
 		gameObj.pointLight = std::make_unique<PointLightComponent>();
 		gameObj.pointLight->lightIntensity = intensity;
 		return gameObj;
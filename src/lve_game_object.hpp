@@ -6,6 +6,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 
 // std
+#include <cstdint>
 #include <memory>
 #include <unordered_map>
 #include <string>
@@ -14,19 +15,44 @@ namespace lve
 {
 	struct TransformComponent
 	{
-		glm::vec3 translation{}; // (position offset)
-		glm::vec3 scale{ 1.0f, 1.0f, 1.0f};
-		glm::vec3 rotation;
+		const glm::vec3& getTranslation() const { return translation; }
+		const glm::vec3& getScale() const { return scale; }
+		const glm::vec3& getRotation() const { return rotation; }
+
+		// every change goes through a setter so the cached matrices know to recompute
+		void setTranslation(const glm::vec3& value) { translation = value; markChanged(); }
+		void setScale(const glm::vec3& value) { scale = value; markChanged(); }
+		void setRotation(const glm::vec3& value) { rotation = value; markChanged(); }
 
 		// Matrix corrsponds to Translate * Ry * Rx * Rz * Scale
 		// Rotations correspond to Tait-bryan angles of Y(1), X(2), Z(3)
 		// https://en.wikipedia.org/wiki/Euler_angles#Rotation_matrix
-		glm::mat4 mat4();
-		glm::mat3 normalMatrix();
+		// Both matrices are cached and only recomputed (together) after the transform changes, so objects that
+		// don't move cost nothing and an object drawn by several passes is computed once
+		const glm::mat4& mat4();
+		const glm::mat3& normalMatrix();
+		bool isDirty() const { return dirty; }
+		// bumped on every change. Unlike the dirty flag nobody clears it, so any number of systems can each
+		// remember the last version they saw
+		uint32_t getVersion() const { return version; }
+
+	private:
+		void markChanged() { dirty = true; version++; }
+		void updateMatrices();
+
+		glm::vec3 translation{}; // (position offset)
+		glm::vec3 scale{ 1.0f, 1.0f, 1.0f};
+		glm::vec3 rotation{};
+
+		glm::mat4 cachedMatrix{ 1.0f };
+		glm::mat3 cachedNormalMatrix{ 1.0f };
+		bool dirty = true;
+		uint32_t version = 0;
 	};
 
 	struct PointLightComponent {
 		float lightIntensity = 1.0f;
+		glm::vec3 color{ 1.0f };
 	};
 
 	class LveGameObject
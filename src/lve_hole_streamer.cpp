@@ -0,0 +1,279 @@
+#include "lve_hole_streamer.hpp"
+
+#include "lve_scene_loader.hpp"
+#include "lve_swap_chain.hpp"
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <utility>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace lve
+{
+	LveHoleStreamer::LveHoleStreamer(LveDevice& device, LveAssetCache& assets, LveScene& scene,
+		const SceneDescription& description, const std::vector<LveScene::Entity>& entities, LveThreadPool& threadPool)
+		: LveHoleStreamer(device, assets, scene, description, entities, Settings{}, threadPool) {}
+
+	LveHoleStreamer::LveHoleStreamer(LveDevice& device, LveAssetCache& assets, LveScene& scene,
+		const SceneDescription& description, const std::vector<LveScene::Entity>& entities, const Settings& settings,
+		LveThreadPool& threadPool)
+		: device{ device }, assets{ assets }, scene{ scene }, description{ description },
+		entities{ entities }, settings{ settings }, threadPool{ threadPool }
+	{
+		holes.resize(description.holes.size());
+	}
+
+	bool LveHoleStreamer::update(int currentHole)
+	{
+		frame++;
+		const int holeCount = static_cast<int>(holes.size());
+		bool changed = false;
+
+		// current hole first so it's at the front of the pool's queue, then the ones ahead, then behind
+		request(currentHole);
+		for (int i = 1; i <= settings.holesAhead; i++)
+		{
+			request((currentHole + i) % holeCount);
+		}
+		for (int i = 1; i <= settings.holesBehind; i++)
+		{
+			request(((currentHole - i) % holeCount + holeCount) % holeCount);
+		}
+
+		// the hole being played has to be drawn, so this is the one case worth waiting for
+		if (holes[currentHole].state == HoleState::LOADING)
+		{
+			finishLoading(currentHole);
+			changed = true;
+		}
+
+		for (int i = 0; i < holeCount; i++)
+		{
+			Hole& hole = holes[i];
+			if (hole.state == HoleState::LOADING
+				&& hole.pending.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			{
+				if (inRange(i, currentHole))
+				{
+					finishLoading(i);
+					changed = true;
+				}
+				else
+				{
+					// went out of range again before it finished, so don't bother uploading it, and don't leave
+					// its parsed meshes sitting in the cache either
+					hole.pending.get();
+					for (const std::string& path : hole.prefetchedModels)
+					{
+						assets.cancelPrefetch(path);
+					}
+					hole.prefetchedModels.clear();
+					hole.state = HoleState::UNLOADED;
+				}
+			}
+			else if ((hole.state == HoleState::UPLOADING || hole.state == HoleState::RESIDENT) && !inRange(i, currentHole))
+			{
+				evict(i);
+				changed = true;
+			}
+		}
+
+		// the current hole's entities have to be in the scene by the time the ball is played on it, the rest
+		// wait for their fences
+		bool uploaded = finishUploads(currentHole);
+
+		if (changed)
+		{
+			assets.collectGarbage();
+		}
+
+		// nothing submitted more than MAX_FRAMES_IN_FLIGHT frames ago can still be using these
+		retired.erase(std::remove_if(retired.begin(), retired.end(), [this](const RetiredModel& model) {
+			return frame - model.frame > LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+		}), retired.end());
+
+		return changed || uploaded;
+	}
+
+	int LveHoleStreamer::getResidentHoleCount() const
+	{
+		return static_cast<int>(std::count_if(holes.begin(), holes.end(),
+			[](const Hole& hole) { return hole.state == HoleState::RESIDENT; }));
+	}
+
+	size_t LveHoleStreamer::getResidentModelBytes() const
+	{
+		std::vector<const LveModel*> models{};
+		for (const Hole& hole : holes)
+		{
+			for (const std::shared_ptr<LveModel>& model : hole.models) models.push_back(model.get());
+		}
+		for (const RetiredModel& model : retired) models.push_back(model.model.get());
+
+		// holes share models, and a retired model can be back in use by a hole that's been loaded again since
+		std::sort(models.begin(), models.end());
+		models.erase(std::unique(models.begin(), models.end()), models.end());
+		size_t bytes = 0;
+		for (const LveModel* model : models)
+		{
+			bytes += model->getMemorySize();
+		}
+		return bytes;
+	}
+
+	bool LveHoleStreamer::inRange(int hole, int currentHole) const
+	{
+		const int holeCount = static_cast<int>(holes.size());
+		int ahead = (hole - currentHole + holeCount) % holeCount;
+		int behind = (currentHole - hole + holeCount) % holeCount;
+		return ahead <= settings.holesAhead || behind <= settings.holesBehind;
+	}
+
+	void LveHoleStreamer::request(int hole)
+	{
+		if (holes[hole].state != HoleState::UNLOADED) return;
+
+		// the cache skips models that are already loaded for another hole, and shares parses already under way
+		std::vector<LveAssetCache::PendingModel> models{};
+		for (const SceneDescription::Object& object : description.objects)
+		{
+			if (object.hole != hole || object.model < 0) continue;
+			std::string path = ENGINE_DIR + description.models[object.model].path;
+			LveAssetCache::PendingModel model = assets.prefetch(path);
+			if (model.valid())
+			{
+				models.push_back(std::move(model));
+				holes[hole].prefetchedModels.push_back(std::move(path));
+			}
+		}
+
+		LveThreadPool& pool = threadPool;
+		holes[hole].pending = threadPool.submit([models, &pool]() {
+			for (const LveAssetCache::PendingModel& model : models)
+			{
+				try
+				{
+					pool.wait(model);
+				}
+				catch (...)
+				{
+					// getModel rethrows it when the hole is finished
+				}
+			}
+		});
+		holes[hole].state = HoleState::LOADING;
+	}
+
+	void LveHoleStreamer::finishLoading(int index)
+	{
+		Hole& hole = holes[index];
+		threadPool.wait(hole.pending);
+		// getModel below answers every prefetch
+		hole.prefetchedModels.clear();
+
+		hole.uploads = std::make_unique<LveUploadBatch>(device);
+		hole.objectModels.resize(description.objects.size());
+		for (size_t i = 0; i < description.objects.size(); i++)
+		{
+			const SceneDescription::Object& object = description.objects[i];
+			if (object.hole != index || object.model < 0) continue;
+
+			// only parses here if another hole had the model when this one was requested, but has been evicted
+			// since. A model another hole is still uploading comes back as it is, which finishUploads allows for
+			std::shared_ptr<LveModel> model = assets.getModel(ENGINE_DIR + description.models[object.model].path, hole.uploads.get());
+			if (std::find(hole.models.begin(), hole.models.end(), model) == hole.models.end())
+			{
+				hole.models.push_back(model);
+			}
+			hole.objectModels[i] = std::move(model);
+		}
+
+		hole.uploads->submit();
+		hole.uploadSequence = ++uploadSequence;
+		hole.state = HoleState::UPLOADING;
+	}
+
+	bool LveHoleStreamer::finishUploads(int mustFinish)
+	{
+		// in submission order, because a hole can share models with one uploaded before it, and its entities
+		// can't be drawn until that earlier upload has landed too
+		bool finished = false;
+		while (true)
+		{
+			int next = -1;
+			for (int i = 0; i < static_cast<int>(holes.size()); i++)
+			{
+				if (holes[i].state == HoleState::UPLOADING
+					&& (next < 0 || holes[i].uploadSequence < holes[next].uploadSequence))
+				{
+					next = i;
+				}
+			}
+			if (next < 0) break;
+
+			bool required = mustFinish >= 0 && holes[mustFinish].state == HoleState::UPLOADING;
+			if (!required && !holes[next].uploads->isComplete()) break;
+			finishUploading(next);
+			finished = true;
+		}
+		return finished;
+	}
+
+	void LveHoleStreamer::finishUploading(int index)
+	{
+		Hole& hole = holes[index];
+		// frees the staging memory, and only blocks if the fence hasn't signalled yet
+		hole.uploads->wait();
+		hole.uploads.reset();
+
+		// streamed objects only have parents that are always loaded or in the same hole, and parents come first
+		std::vector<LveScene::Entity> holeEntities(description.objects.size());
+		for (size_t i = 0; i < description.objects.size(); i++)
+		{
+			const SceneDescription::Object& object = description.objects[i];
+			if (object.hole != index) continue;
+
+			LveScene::Entity parent{};
+			if (object.parent >= 0)
+			{
+				parent = description.objects[object.parent].hole == index ? holeEntities[object.parent] : entities[object.parent];
+			}
+			holeEntities[i] = scene.add(LveSceneLoader::makeGameObject(description, object, std::move(hole.objectModels[i])), object.name, parent);
+			hole.entities.push_back(holeEntities[i]);
+		}
+		hole.objectModels.clear();
+		hole.state = HoleState::RESIDENT;
+	}
+
+	void LveHoleStreamer::evict(int index)
+	{
+		Hole& hole = holes[index];
+		if (hole.uploads)
+		{
+			// nothing has drawn its models yet, but the copies into them can still be running
+			hole.uploads->wait();
+			hole.uploads.reset();
+			hole.objectModels.clear();
+		}
+
+		for (LveScene::Entity entity : hole.entities)
+		{
+			// children go with their parents, and remove ignores handles that are already gone
+			scene.remove(entity);
+		}
+		hole.entities.clear();
+
+		for (std::shared_ptr<LveModel>& model : hole.models)
+		{
+			retired.push_back(RetiredModel{ frame, std::move(model) });
+		}
+		hole.models.clear();
+
+		hole.state = HoleState::UNLOADED;
+	}
+} // namespace lve
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "lve_asset_cache.hpp"
+#include "lve_device.hpp"
+#include "lve_model.hpp"
+#include "lve_scene.hpp"
+#include "lve_scene_description.hpp"
+#include "lve_thread_pool.hpp"
+#include "lve_upload_batch.hpp"
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lve
+{
+	// Keeps only the meshes of the holes around the one being played loaded, in the scene and on the GPU.
+	// Everything tagged with a hole in the scene description is left to this, so memory scales with the window of
+	// holes rather than the length of the course. Colliders aren't streamed: every hole's stay in the course
+	// world, so what the ball hits never depends on how far along the loading is (and the game and a headless
+	// replay collide with the same course).
+	// Holes coming into range have their models parsed on the thread pool, and uploaded from update() once the
+	// parse is done, all of a hole's meshes in one submit. The upload isn't waited on: the hole's entities are
+	// added to the scene by a later update() once the upload's fence has signalled, so the copies overlap with
+	// the frames drawn in between. Holes going out of range are removed, and their GPU buffers are freed a few
+	// frames later once no frame in flight can still be drawing them. Models come from the asset cache, so ones
+	// shared between holes (or with the rest of the scene) are only loaded once
+	class LveHoleStreamer
+	{
+	public:
+		struct Settings
+		{
+			// holes kept loaded before and after the current one. The course wraps around after the last hole
+			int holesBehind = 1;
+			int holesAhead = 1;
+		};
+
+		// entities are the loader's, so streamed objects can be parented to ones that are always loaded
+		LveHoleStreamer(LveDevice& device, LveAssetCache& assets, LveScene& scene,
+			const SceneDescription& description, const std::vector<LveScene::Entity>& entities,
+			LveThreadPool& threadPool = LveThreadPool::global());
+		LveHoleStreamer(LveDevice& device, LveAssetCache& assets, LveScene& scene,
+			const SceneDescription& description, const std::vector<LveScene::Entity>& entities, const Settings& settings,
+			LveThreadPool& threadPool = LveThreadPool::global());
+
+		LveHoleStreamer(const LveHoleStreamer&) = delete;
+		LveHoleStreamer& operator=(const LveHoleStreamer&) = delete;
+
+		// call once a frame with the ball's hole. Starts loading holes that came into range, finishes the ones
+		// that are ready and evicts the ones out of range. Only blocks if the current hole itself isn't loaded or
+		// uploaded yet. Returns true if the set of loaded holes changed
+		bool update(int currentHole);
+
+		bool isResident(int hole) const { return holes[hole].state == HoleState::RESIDENT; }
+		int getResidentHoleCount() const;
+		// vertex and index data of every model currently loaded through the streamer (including ones waiting for
+		// the frames in flight to let go of them). Objects that are always loaded aren't counted
+		size_t getResidentModelBytes() const;
+
+	private:
+		enum class HoleState
+		{
+			UNLOADED,
+			LOADING,
+			// meshes still being copied to the GPU, no entities in the scene yet
+			UPLOADING,
+			RESIDENT,
+		};
+
+		struct Hole
+		{
+			HoleState state = HoleState::UNLOADED;
+			// ready once the hole's models have been parsed
+			std::future<void> pending;
+			// models prefetched for the hole, to cancel if it goes out of range before it's finished
+			std::vector<std::string> prefetchedModels;
+			std::vector<LveScene::Entity> entities;
+			std::vector<std::shared_ptr<LveModel>> models;
+			// while uploading: each of the hole's objects' model (by object index) for when its entities are
+			// added, and the batch its new models are in. Declared after the models so it's destroyed (and waited
+			// on) before they are
+			std::vector<std::shared_ptr<LveModel>> objectModels;
+			uint64_t uploadSequence = 0;
+			std::unique_ptr<LveUploadBatch> uploads;
+		};
+
+		// models that have been evicted but might still be in use by a frame in flight
+		struct RetiredModel
+		{
+			uint64_t frame;
+			std::shared_ptr<LveModel> model;
+		};
+
+		bool inRange(int hole, int currentHole) const;
+		void request(int hole);
+		void finishLoading(int hole);
+		// finishes uploading holes in the order they were submitted, as far as their fences have signalled, or
+		// always as far as mustFinish if that's given. Returns true if any hole became resident
+		bool finishUploads(int mustFinish);
+		void finishUploading(int hole);
+		void evict(int hole);
+
+		LveDevice& device;
+		LveAssetCache& assets;
+		LveScene& scene;
+		const SceneDescription& description;
+		const std::vector<LveScene::Entity>& entities;
+		Settings settings;
+		LveThreadPool& threadPool;
+
+		std::vector<Hole> holes;
+		std::vector<RetiredModel> retired;
+		uint64_t frame = 0;
+		uint64_t uploadSequence = 0;
+	};
+} // namespace lve
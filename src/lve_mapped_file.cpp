@@ -0,0 +1,140 @@
+#include "lve_mapped_file.hpp"
+
+// std
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace lve
+{
+	LveMappedFile::LveMappedFile(const std::string& filename)
+	{
+		if (!open(filename))
+		{
+			throw std::runtime_error("failed to map file: " + filename);
+		}
+	}
+
+	LveMappedFile::~LveMappedFile()
+	{
+		close();
+	}
+
+	LveMappedFile::LveMappedFile(LveMappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	LveMappedFile& LveMappedFile::operator=(LveMappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			std::swap(mapped, other.mapped);
+			std::swap(size, other.size);
+			std::swap(opened, other.opened);
+#ifdef _WIN32
+			std::swap(fileHandle, other.fileHandle);
+			std::swap(mappingHandle, other.mappingHandle);
+#endif
+		}
+		return *this;
+	}
+
+#ifdef _WIN32
+	bool LveMappedFile::open(const std::string& filename)
+	{
+		close();
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize))
+		{
+			CloseHandle(file);
+			return false;
+		}
+		fileHandle = file;
+		size = static_cast<size_t>(fileSize.QuadPart);
+		opened = true;
+		if (size == 0) return true;
+
+		mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mappingHandle != nullptr)
+		{
+			mapped = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		}
+		if (mapped == nullptr)
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void LveMappedFile::close()
+	{
+		if (mapped != nullptr) UnmapViewOfFile(mapped);
+		if (mappingHandle != nullptr) CloseHandle(mappingHandle);
+		if (fileHandle != nullptr) CloseHandle(fileHandle);
+		mapped = nullptr;
+		mappingHandle = nullptr;
+		fileHandle = nullptr;
+		size = 0;
+		opened = false;
+	}
+#else
+	bool LveMappedFile::open(const std::string& filename)
+	{
+		close();
+		int file = ::open(filename.c_str(), O_RDONLY);
+		if (file < 0) return false;
+
+		struct stat info{};
+		if (fstat(file, &info) != 0)
+		{
+			::close(file);
+			return false;
+		}
+		size = static_cast<size_t>(info.st_size);
+		opened = true;
+		if (size > 0)
+		{
+			void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (view == MAP_FAILED)
+			{
+				::close(file);
+				size = 0;
+				opened = false;
+				return false;
+			}
+			mapped = view;
+			// read front to back by everything that maps files here
+			madvise(mapped, size, MADV_SEQUENTIAL);
+		}
+		// the mapping keeps its own reference to the file
+		::close(file);
+		return true;
+	}
+
+	void LveMappedFile::close()
+	{
+		if (mapped != nullptr) munmap(mapped, size);
+		mapped = nullptr;
+		size = 0;
+		opened = false;
+	}
+#endif
+} // namespace lve
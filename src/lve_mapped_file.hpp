@@ -0,0 +1,43 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <string>
+
+namespace lve
+{
+	// Read-only memory mapping of a whole file. The pages are only read in from disk as they're touched, so
+	// handing the data straight to something like a staging buffer costs no more than the copy itself.
+	// Move-only, and the mapping goes away with the object
+	class LveMappedFile
+	{
+	public:
+		LveMappedFile() = default;
+		// throws if the file can't be opened or mapped
+		explicit LveMappedFile(const std::string& filename);
+		~LveMappedFile();
+
+		LveMappedFile(const LveMappedFile&) = delete;
+		LveMappedFile& operator=(const LveMappedFile&) = delete;
+		LveMappedFile(LveMappedFile&& other) noexcept;
+		LveMappedFile& operator=(LveMappedFile&& other) noexcept;
+
+		// like the constructor, but returns false instead of throwing
+		bool open(const std::string& filename);
+		void close();
+
+		bool isOpen() const { return opened; }
+		const unsigned char* data() const { return static_cast<const unsigned char*>(mapped); }
+		size_t getSize() const { return size; }
+
+	private:
+		void* mapped = nullptr;
+		size_t size = 0;
+		// empty files can't be mapped, but they still opened fine
+		bool opened = false;
+#ifdef _WIN32
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+#endif
+	};
+} // namespace lve
@@ -0,0 +1,118 @@
+#include "lve_mesh_cache.hpp"
+
+// std
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace lve
+{
+	namespace
+	{
+		constexpr char MAGIC[4] = { 'L', 'V', 'M', 'S' };
+		// 2: meshes are stored after LveMeshOptimizer has reordered them
+		constexpr uint16_t VERSION = 2;
+
+		struct Header
+		{
+			char magic[4];
+			uint16_t version;
+			uint16_t vertexSize;
+			uint64_t sourceHash;
+			uint32_t vertexCount;
+			uint32_t indexCount;
+		};
+		// vertices start right after the header and need their floats aligned
+		static_assert(sizeof(Header) % alignof(LveModel::Vertex) == 0, "mesh cache header breaks vertex alignment");
+		static_assert(sizeof(LveModel::Vertex) % alignof(uint32_t) == 0, "mesh cache vertices break index alignment");
+
+		uint64_t fnv1a(const unsigned char* data, size_t size)
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= data[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	}
+
+	uint64_t LveMeshCache::hashFile(const std::string& filename)
+	{
+		LveMappedFile file{};
+		if (!file.open(filename)) return 0;
+		return fnv1a(file.data(), file.getSize());
+	}
+
+	bool LveMeshCache::load(const std::string& sourcePath, Mesh& mesh)
+	{
+		LveMappedFile file{};
+		if (!file.open(cachePath(sourcePath)) || file.getSize() < sizeof(Header)) return false;
+
+		Header header{};
+		std::memcpy(&header, file.data(), sizeof(Header));
+		if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+			|| header.vertexSize != sizeof(LveModel::Vertex))
+		{
+			return false;
+		}
+
+		size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(LveModel::Vertex);
+		size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+		if (file.getSize() != sizeof(Header) + vertexBytes + indexBytes) return false;
+
+		// the source is only read to check the hash, which is far cheaper than parsing it
+		if (header.sourceHash != hashFile(sourcePath)) return false;
+
+		mesh.vertices = reinterpret_cast<const LveModel::Vertex*>(file.data() + sizeof(Header));
+		mesh.vertexCount = header.vertexCount;
+		mesh.indices = reinterpret_cast<const uint32_t*>(file.data() + sizeof(Header) + vertexBytes);
+		mesh.indexCount = header.indexCount;
+		mesh.file = std::move(file);
+		return true;
+	}
+
+	bool LveMeshCache::save(const std::string& sourcePath, const LveModel::Builder& builder)
+	{
+		Header header{};
+		std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+		header.version = VERSION;
+		header.vertexSize = sizeof(LveModel::Vertex);
+		header.sourceHash = hashFile(sourcePath);
+		header.vertexCount = static_cast<uint32_t>(builder.vertices.size());
+		header.indexCount = static_cast<uint32_t>(builder.indices.size());
+
+		// written under a temporary name and renamed, so a half written file is never picked up by load. The name
+		// is unique to this write, since two threads can be saving the same mesh at once
+		static std::atomic<uint32_t> writes{ 0 };
+		std::string path = cachePath(sourcePath);
+		std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()))
+			+ "." + std::to_string(writes++) + ".tmp";
+		{
+			std::ofstream file{ tempPath, std::ios::binary | std::ios::trunc };
+			if (!file.is_open()) return false;
+			file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+			file.write(reinterpret_cast<const char*>(builder.vertices.data()), builder.vertices.size() * sizeof(LveModel::Vertex));
+			file.write(reinterpret_cast<const char*>(builder.indices.data()), builder.indices.size() * sizeof(uint32_t));
+			if (!file.good())
+			{
+				file.close();
+				std::remove(tempPath.c_str());
+				return false;
+			}
+		}
+
+		std::remove(path.c_str());
+		if (std::rename(tempPath.c_str(), path.c_str()) != 0)
+		{
+			std::remove(tempPath.c_str());
+			return false;
+		}
+		return true;
+	}
+} // namespace lve
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "lve_mapped_file.hpp"
+#include "lve_model.hpp"
+
+// std
+#include <cstdint>
+#include <string>
+
+namespace lve
+{
+	// Binary copies of parsed meshes, so OBJ files are only parsed (and their vertices deduplicated) once.
+	// A cache file sits next to its source with CACHE_EXTENSION on the end, and holds a header followed by
+	// the final vertex and index arrays exactly as they go to the GPU. The header keeps a hash of the source
+	// file, so editing the OBJ is enough to have it parsed again, plus the vertex size so a change to
+	// LveModel::Vertex invalidates every cache file.
+	// Loading maps the file, so the arrays can be copied straight into a staging buffer
+	class LveMeshCache
+	{
+	public:
+		static constexpr const char* CACHE_EXTENSION = ".lvemesh";
+
+		// a mapped cache file. The pointers point into the mapping and are only good while this is alive
+		class Mesh
+		{
+		public:
+			const LveModel::Vertex* vertices = nullptr;
+			uint32_t vertexCount = 0;
+			const uint32_t* indices = nullptr;
+			uint32_t indexCount = 0;
+
+		private:
+			friend class LveMeshCache;
+			LveMappedFile file;
+		};
+
+		static std::string cachePath(const std::string& sourcePath) { return sourcePath + CACHE_EXTENSION; }
+
+		// false if there's no cache file for the source yet, or it's out of date or unreadable
+		static bool load(const std::string& sourcePath, Mesh& mesh);
+		// writes the cache file for a freshly parsed source. Returns false if it couldn't be written (say the
+		// models directory is read-only), which only means the next launch parses it again
+		static bool save(const std::string& sourcePath, const LveModel::Builder& builder);
+
+		// FNV-1a over the whole file, 0 if it can't be read
+		static uint64_t hashFile(const std::string& filename);
+	};
+} // namespace lve
@@ -0,0 +1,147 @@
+#include "lve_mesh_optimizer.hpp"
+
+// std
+#include <algorithm>
+
+namespace lve
+{
+	void LveMeshOptimizer::optimize(LveModel::Builder& builder)
+	{
+		optimizeVertexCache(builder.indices, builder.vertices.size());
+		optimizeVertexFetch(builder.vertices, builder.indices);
+	}
+
+	void LveMeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+	{
+		const size_t triangleCount = indices.size() / 3;
+		if (triangleCount == 0 || vertexCount == 0) return;
+
+		// triangles using each vertex, as offsets into one flat array
+		std::vector<uint32_t> live(vertexCount, 0);
+		for (uint32_t index : indices)
+		{
+			live[index]++;
+		}
+		std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+		for (size_t v = 0; v < vertexCount; v++)
+		{
+			adjacencyOffsets[v + 1] = adjacencyOffsets[v] + live[v];
+		}
+		std::vector<uint32_t> adjacency(adjacencyOffsets.back());
+		std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			for (size_t corner = 0; corner < 3; corner++)
+			{
+				adjacency[fill[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+			}
+		}
+
+		std::vector<uint32_t> cacheTime(vertexCount, 0);
+		std::vector<bool> emitted(triangleCount, false);
+		std::vector<uint32_t> deadEnd{};
+		std::vector<uint32_t> candidates{};
+		std::vector<uint32_t> output{};
+		output.reserve(indices.size());
+
+		// the time stamp goes up once per cache miss, so a vertex is still cached while now - its time <= cacheSize
+		uint32_t now = cacheSize + 1;
+		size_t scan = 0;
+		auto skipDeadEnd = [&]() -> int64_t {
+			while (!deadEnd.empty())
+			{
+				uint32_t vertex = deadEnd.back();
+				deadEnd.pop_back();
+				if (live[vertex] > 0) return vertex;
+			}
+			for (; scan < vertexCount; scan++)
+			{
+				if (live[scan] > 0) return static_cast<int64_t>(scan);
+			}
+			return -1;
+		};
+
+		int64_t fan = skipDeadEnd();
+		while (fan >= 0)
+		{
+			// emit every remaining triangle around the fanning vertex
+			candidates.clear();
+			for (uint32_t i = adjacencyOffsets[fan]; i < adjacencyOffsets[fan + 1]; i++)
+			{
+				uint32_t triangle = adjacency[i];
+				if (emitted[triangle]) continue;
+				for (size_t corner = 0; corner < 3; corner++)
+				{
+					uint32_t vertex = indices[triangle * 3 + corner];
+					output.push_back(vertex);
+					deadEnd.push_back(vertex);
+					candidates.push_back(vertex);
+					live[vertex]--;
+					if (now - cacheTime[vertex] > cacheSize)
+					{
+						cacheTime[vertex] = now++;
+					}
+				}
+				emitted[triangle] = true;
+			}
+
+			// next, the candidate that will still be in the cache once its own fan is done and has been there
+			// longest, since it's the one about to drop out
+			int64_t next = -1;
+			int64_t bestPriority = -1;
+			for (uint32_t vertex : candidates)
+			{
+				if (live[vertex] == 0) continue;
+				int64_t priority = 0;
+				if (now - cacheTime[vertex] + 2 * live[vertex] <= cacheSize)
+				{
+					priority = now - cacheTime[vertex];
+				}
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					next = vertex;
+				}
+			}
+			fan = next >= 0 ? next : skipDeadEnd();
+		}
+
+		indices.swap(output);
+	}
+
+	void LveMeshOptimizer::optimizeVertexFetch(std::vector<LveModel::Vertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		constexpr uint32_t UNUSED = ~0u;
+		std::vector<uint32_t> remap(vertices.size(), UNUSED);
+		std::vector<LveModel::Vertex> ordered{};
+		ordered.reserve(vertices.size());
+		for (uint32_t& index : indices)
+		{
+			if (remap[index] == UNUSED)
+			{
+				remap[index] = static_cast<uint32_t>(ordered.size());
+				ordered.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices.swap(ordered);
+	}
+
+	float LveMeshOptimizer::computeAcmr(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize)
+	{
+		if (indices.size() < 3) return 0.0f;
+
+		// in a FIFO a vertex is cached until cacheSize more misses have pushed it out
+		constexpr uint64_t NEVER = ~0ull;
+		std::vector<uint64_t> missNumber(vertexCount, NEVER);
+		uint64_t misses = 0;
+		for (uint32_t index : indices)
+		{
+			if (missNumber[index] == NEVER || misses - missNumber[index] >= cacheSize)
+			{
+				missNumber[index] = misses++;
+			}
+		}
+		return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+	}
+} // namespace lve
@@ -1,39 +1,47 @@
 #include "lve_model.hpp"
 
-#include "lve_utils.hpp"
-
-// libs
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
+#include "lve_mesh_cache.hpp"
+#include "lve_mesh_optimizer.hpp"
+#include "lve_obj_reader.hpp"
 
 // std
+#include <atomic>
 #include <cassert>
 #include <cstring>
-#include <unordered_map>
+#include <stdexcept>
 
 #ifndef ENGINE_DIR
 #define ENGINE_DIR "../"
 #endif
 
-namespace std
-{
-    template<>
-    struct hash<lve::LveModel::Vertex> {
-        size_t operator()(lve::LveModel::Vertex const& vertex) const {
-            size_t seed = 0;
-            lve::hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
-            return seed;
-        }
-    };
-}
-
 namespace lve {
 
-LveModel::LveModel(LveDevice &device, const LveModel::Builder &builder) : lveDevice{device} {
-  createVertexBuffers(builder.vertices);
-  createIndexBuffers(builder.indices);
+namespace {
+std::atomic<uint32_t> nextModelId{0};
+}
+
+LveModel::LveModel(LveDevice &device, const LveModel::Builder &builder)
+    : LveModel(device, builder.vertices.data(), static_cast<uint32_t>(builder.vertices.size()), builder.indices.data(),
+               static_cast<uint32_t>(builder.indices.size())) {}
+
+LveModel::LveModel(LveDevice &device, const LveModel::Builder &builder, LveUploadBatch &uploads)
+    : LveModel(device, builder.vertices.data(), static_cast<uint32_t>(builder.vertices.size()), builder.indices.data(),
+               static_cast<uint32_t>(builder.indices.size()), &uploads) {}
+
+LveModel::LveModel(LveDevice &device, const Vertex *vertices, uint32_t vertexCount, const uint32_t *indices,
+                   uint32_t indexCount, LveUploadBatch *uploads)
+    : lveDevice{device}, id{nextModelId++} {
+  if (uploads != nullptr) {
+    createVertexBuffers(vertices, vertexCount, *uploads);
+    createIndexBuffers(indices, indexCount, *uploads);
+  } else {
+    // vertices and indices still go up together in one submit
+    LveUploadBatch modelUploads{device};
+    createVertexBuffers(vertices, vertexCount, modelUploads);
+    createIndexBuffers(indices, indexCount, modelUploads);
+    modelUploads.wait();
+  }
+  computeBounds(vertices, vertexCount);
 }
 
 LveModel::~LveModel() {
@@ -41,29 +49,53 @@ LveModel::~LveModel() {
 
 std::unique_ptr<LveModel> LveModel::createModelFromFile(LveDevice& device, const std::string& filepath)
 {
+    std::string path = ENGINE_DIR + filepath;
+
+    // a cached mesh goes from the mapping straight into the staging buffers
+    LveMeshCache::Mesh mesh{};
+    if (LveMeshCache::load(path, mesh))
+    {
+        return std::make_unique<LveModel>(device, mesh.vertices, mesh.vertexCount, mesh.indices, mesh.indexCount);
+    }
+
     Builder builder{};
-    builder.loadModel(ENGINE_DIR + filepath);
+    builder.loadModel(path);
 
     return std::make_unique<LveModel>(device, builder);
 }
 
-void LveModel::createVertexBuffers(const std::vector<Vertex> &vertices) {
-  vertexCount = static_cast<uint32_t>(vertices.size());
+void LveModel::Bounds::transformedBox(const glm::mat4 &matrix, glm::vec3 &outMin, glm::vec3 &outMax) const {
+  glm::vec3 boxCenter{matrix * glm::vec4{(min + max) * 0.5f, 1.0f}};
+  glm::vec3 halfExtents = (max - min) * 0.5f;
+  glm::vec3 extents = glm::abs(glm::vec3{matrix[0]}) * halfExtents.x + glm::abs(glm::vec3{matrix[1]}) * halfExtents.y +
+                      glm::abs(glm::vec3{matrix[2]}) * halfExtents.z;
+  outMin = boxCenter - extents;
+  outMax = boxCenter + extents;
+}
+
+void LveModel::computeBounds(const Vertex *vertices, uint32_t count) {
+  bounds.min = vertices[0].position;
+  bounds.max = vertices[0].position;
+  for (uint32_t i = 0; i < count; i++) {
+    bounds.min = glm::min(bounds.min, vertices[i].position);
+    bounds.max = glm::max(bounds.max, vertices[i].position);
+  }
+
+  bounds.center = (bounds.min + bounds.max) * 0.5f;
+  float radiusSquared = 0.0f;
+  for (uint32_t i = 0; i < count; i++) {
+    glm::vec3 offset = vertices[i].position - bounds.center;
+    radiusSquared = glm::max(radiusSquared, glm::dot(offset, offset));
+  }
+  bounds.radius = glm::sqrt(radiusSquared);
+}
+
+void LveModel::createVertexBuffers(const Vertex *vertices, uint32_t count, LveUploadBatch &uploads) {
+  vertexCount = count;
   assert(vertexCount >= 3 && "Vertex count must be at least 3");
   VkDeviceSize bufferSize = sizeof(vertices[0]) * vertexCount;
   uint32_t vertexSize = sizeof(vertices[0]);
 
-  LveBuffer stagingBuffer{
-      lveDevice,
-      vertexSize,
-      vertexCount,
-      VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-      VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-  };
-
-  stagingBuffer.map();
-  stagingBuffer.writeToBuffer((void*)vertices.data());
-
   vertexBuffer = std::make_unique<LveBuffer>(
       lveDevice,
       vertexSize,
@@ -71,30 +103,30 @@ void LveModel::createVertexBuffers(const std::vector<Vertex> &vertices) {
       VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-  lveDevice.copyBuffer(stagingBuffer.getBuffer(), vertexBuffer->getBuffer(), bufferSize);
+  uploads.copyToBuffer(vertices, bufferSize, vertexBuffer->getBuffer());
 }
 
-void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
-    indexCount = static_cast<uint32_t>(indices.size());
+void LveModel::createIndexBuffers(const uint32_t *indices, uint32_t count, LveUploadBatch &uploads) {
+    indexCount = count;
     hasIndexBuffer = indexCount > 0;
 
     if (!hasIndexBuffer) {
         return;
     }
 
-    VkDeviceSize bufferSize = sizeof(indices[0]) * indexCount;
-    uint32_t indexSize = sizeof(indices[0]);
-
-    LveBuffer stagingBuffer{
-        lveDevice,
-        indexSize,
-        indexCount,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-    };
-
-    stagingBuffer.map();
-    stagingBuffer.writeToBuffer((void*)indices.data());
+    // half the index data whenever every vertex fits in 16 bits, which is nearly every mesh in the game.
+    // The batch copies into staging straight away, so the narrowed copy only has to live for this call
+    std::vector<uint16_t> shortIndices{};
+    const void *indexData = indices;
+    uint32_t indexSize = sizeof(uint32_t);
+    indexType = VK_INDEX_TYPE_UINT32;
+    if (vertexCount <= 65536) {
+        shortIndices.assign(indices, indices + indexCount);
+        indexData = shortIndices.data();
+        indexSize = sizeof(uint16_t);
+        indexType = VK_INDEX_TYPE_UINT16;
+    }
+    VkDeviceSize bufferSize = static_cast<VkDeviceSize>(indexSize) * indexCount;
 
     indexBuffer = std::make_unique<LveBuffer>(
         lveDevice,
@@ -103,7 +135,7 @@ void LveModel::createIndexBuffers(const std::vector<uint32_t> &indices) {
         VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    lveDevice.copyBuffer(stagingBuffer.getBuffer(), indexBuffer->getBuffer(), bufferSize);
+    uploads.copyToBuffer(indexData, bufferSize, indexBuffer->getBuffer());
 }
 
 void LveModel::draw(VkCommandBuffer commandBuffer) {
@@ -123,7 +155,7 @@ void LveModel::bind(VkCommandBuffer commandBuffer) {
 
   if (hasIndexBuffer)
   {
-      vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0, VK_INDEX_TYPE_UINT32);
+      vkCmdBindIndexBuffer(commandBuffer, indexBuffer->getBuffer(), 0, indexType);
   }
 }
 
@@ -148,66 +180,19 @@ std::vector<VkVertexInputAttributeDescription> LveModel::Vertex::getAttributeDes
 
 void LveModel::Builder::loadModel(const std::string& filepath)
 {
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
-
-    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str()))
+    LveMeshCache::Mesh mesh{};
+    if (LveMeshCache::load(filepath, mesh))
     {
-        throw std::runtime_error(warn + err);
+        vertices.assign(mesh.vertices, mesh.vertices + mesh.vertexCount);
+        indices.assign(mesh.indices, mesh.indices + mesh.indexCount);
+        return;
     }
 
-    vertices.clear();
-    indices.clear();
+    LveObjReader::read(filepath, *this);
+    LveMeshOptimizer::optimize(*this);
 
-    std::unordered_map<Vertex, uint32_t> uniqueVertices{};
-    for (const auto& shape : shapes)
-    {
-        for (const auto& index : shape.mesh.indices)
-        {
-            Vertex vertex{};
-
-            if (index.vertex_index >= 0)
-            {
-                vertex.position = {
-                    attrib.vertices[3 * index.vertex_index + 0],
-                    attrib.vertices[3 * index.vertex_index + 1],
-                    attrib.vertices[3 * index.vertex_index + 2]
-                };
-                
-                vertex.color = {
-                    attrib.colors[3 * index.vertex_index + 0],
-                    attrib.colors[3 * index.vertex_index + 1],
-                    attrib.colors[3 * index.vertex_index + 2]
-                };
-            }
-
-            if (index.normal_index >= 0)
-            {
-                vertex.normal = {
-                    attrib.normals[3 * index.normal_index + 0],
-                    attrib.normals[3 * index.normal_index + 1],
-                    attrib.normals[3 * index.normal_index + 2]
-                };
-            }
-
-            if (index.texcoord_index >= 0)
-            {
-                vertex.uv = {
-                    attrib.texcoords[2 * index.texcoord_index + 0],
-                    attrib.texcoords[2 * index.texcoord_index + 1]
-                };
-            }
-
-            if (uniqueVertices.count(vertex) == 0)
-            {
-                uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-                vertices.push_back(vertex);
-            }
-            indices.push_back(uniqueVertices[vertex]);
-        }
-    }
+    // only costs anything the first time, or after the OBJ changes
+    LveMeshCache::save(filepath, *this);
 }
 
 }  // namespace lve
\ No newline at end of file
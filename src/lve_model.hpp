@@ -2,6 +2,7 @@
 
 #include "lve_device.hpp"
 #include "lve_buffer.hpp"
+#include "lve_upload_batch.hpp"
 
 // libs
 #define GLM_FORCE_RADIANS
@@ -29,6 +30,18 @@ class LveModel {
     }
   };
 
+  // model space bounds, worked out from the vertices at load time
+  struct Bounds {
+      glm::vec3 min{};
+      glm::vec3 max{};
+      // centered on the box, with the radius reaching the furthest vertex (tighter than the box's corners)
+      glm::vec3 center{};
+      float radius = 0.0f;
+
+      // axis aligned box around this box once it's been transformed by matrix
+      void transformedBox(const glm::mat4 &matrix, glm::vec3 &outMin, glm::vec3 &outMax) const;
+  };
+
   struct Builder {
       std::vector<Vertex> vertices{};
       std::vector<uint32_t> indices{};
@@ -36,7 +49,14 @@ class LveModel {
       void loadModel(const std::string& filepath);
   };
 
+  // uploads the mesh and waits for it, so the model can be drawn straight away
   LveModel(LveDevice &device, const LveModel::Builder &builder);
+  // only stages the mesh into uploads. The model can't be drawn until uploads has been waited on
+  LveModel(LveDevice &device, const LveModel::Builder &builder, LveUploadBatch &uploads);
+  // copies the arrays into staging memory, so they only need to live for the call. Waits for the upload
+  // itself unless it's given a batch to go in
+  LveModel(LveDevice &device, const Vertex *vertices, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+           LveUploadBatch *uploads = nullptr);
   ~LveModel();
 
   LveModel(const LveModel &) = delete;
@@ -47,11 +67,23 @@ class LveModel {
   void bind(VkCommandBuffer commandBuffer);
   void draw(VkCommandBuffer commandBuffer);
 
+  const Bounds& getBounds() const { return bounds; }
+  // unique per model for the life of the program, so it can go into sort keys in place of the pointer
+  uint32_t getId() const { return id; }
+  // vertex and index data on the GPU
+  VkDeviceSize getMemorySize() const {
+      VkDeviceSize indexSize = indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+      return sizeof(Vertex) * vertexCount + indexSize * indexCount;
+  }
+
  private:
-  void createVertexBuffers(const std::vector<Vertex> &vertices);
-  void createIndexBuffers(const std::vector<uint32_t> &indices);
+  void createVertexBuffers(const Vertex *vertices, uint32_t count, LveUploadBatch &uploads);
+  void createIndexBuffers(const uint32_t *indices, uint32_t count, LveUploadBatch &uploads);
+  void computeBounds(const Vertex *vertices, uint32_t count);
 
   LveDevice &lveDevice;
+  uint32_t id;
+  Bounds bounds{};
 
   std::unique_ptr<LveBuffer> vertexBuffer;
   uint32_t vertexCount;
@@ -59,5 +91,7 @@ class LveModel {
   bool hasIndexBuffer = false;
   std::unique_ptr<LveBuffer> indexBuffer;
   uint32_t indexCount;
+  // 16 bit whenever the vertex count allows it
+  VkIndexType indexType = VK_INDEX_TYPE_UINT32;
 };
 }  // namespace lve
@@ -0,0 +1,345 @@
+#include "lve_obj_reader.hpp"
+
+#include "lve_mapped_file.hpp"
+#include "lve_vertex_index_map.hpp"
+
+// std
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace lve
+{
+	namespace
+	{
+		// what one chunk of the file parsed into. Corners are (position, texcoord, normal) triples, -1 for a
+		// missing texcoord or normal. Absolute indices are already global, relative ones are counted from the
+		// start of the chunk until the chunks are stitched together, so they're listed in relativeCorners
+		struct Chunk
+		{
+			const char* begin;
+			const char* end;
+			std::vector<float> positions;
+			std::vector<float> colors;
+			std::vector<float> texcoords;
+			std::vector<float> normals;
+			std::vector<int32_t> corners;
+			std::vector<size_t> relativeCorners;
+			// first thing that went wrong, since exceptions can't leave a pool task safely
+			std::string error;
+		};
+
+		const char* skipSpaces(const char* p, const char* end)
+		{
+			while (p < end && (*p == ' ' || *p == '\t')) p++;
+			return p;
+		}
+
+		bool parseFloat(const char*& p, const char* end, float& value)
+		{
+			p = skipSpaces(p, end);
+			// from_chars doesn't take a leading plus, though some exporters write one
+			if (p < end && *p == '+') p++;
+			auto result = std::from_chars(p, end, value);
+			if (result.ec != std::errc{}) return false;
+			p = result.ptr;
+			return true;
+		}
+
+		bool parseInt(const char*& p, const char* end, int32_t& value)
+		{
+			if (p < end && *p == '+') p++;
+			auto result = std::from_chars(p, end, value);
+			if (result.ec != std::errc{}) return false;
+			p = result.ptr;
+			return true;
+		}
+
+		// reads floats until the end of the line, up to max of them
+		size_t parseFloats(const char*& p, const char* end, float* values, size_t max)
+		{
+			size_t count = 0;
+			while (count < max && parseFloat(p, end, values[count]))
+			{
+				count++;
+			}
+			return count;
+		}
+
+		// one v/vt/vn element of a face corner. OBJ counts from 1, and negative indices count back from the
+		// last element read so far
+		bool parseCornerIndex(const char*& p, const char* end, size_t localCount, int32_t& index, bool& relative)
+		{
+			int32_t raw;
+			if (!parseInt(p, end, raw) || raw == 0) return false;
+			relative = raw < 0;
+			index = relative ? static_cast<int32_t>(localCount) + raw : raw - 1;
+			return true;
+		}
+
+		void parseFace(const char* p, const char* end, Chunk& chunk, std::vector<int32_t>& polygon,
+			std::vector<uint8_t>& polygonRelative)
+		{
+			polygon.clear();
+			polygonRelative.clear();
+			size_t counts[3] = { chunk.positions.size() / 3, chunk.texcoords.size() / 2, chunk.normals.size() / 3 };
+
+			while ((p = skipSpaces(p, end)) < end)
+			{
+				int32_t corner[3] = { -1, -1, -1 };
+				bool relative[3] = { false, false, false };
+				if (!parseCornerIndex(p, end, counts[0], corner[0], relative[0]))
+				{
+					chunk.error = "bad face";
+					return;
+				}
+				for (int element = 1; element < 3 && p < end && *p == '/'; element++)
+				{
+					p++;
+					// v//vn leaves the texcoord out
+					if (p < end && *p == '/') continue;
+					if (!parseCornerIndex(p, end, counts[element], corner[element], relative[element]))
+					{
+						chunk.error = "bad face";
+						return;
+					}
+				}
+				for (int element = 0; element < 3; element++)
+				{
+					polygon.push_back(corner[element]);
+					polygonRelative.push_back(relative[element]);
+				}
+			}
+
+			size_t cornerCount = polygon.size() / 3;
+			if (cornerCount < 3)
+			{
+				chunk.error = "face with fewer than 3 corners";
+				return;
+			}
+			for (size_t i = 1; i + 1 < cornerCount; i++)
+			{
+				for (size_t corner : { size_t{ 0 }, i, i + 1 })
+				{
+					for (size_t element = 0; element < 3; element++)
+					{
+						if (polygonRelative[corner * 3 + element])
+						{
+							chunk.relativeCorners.push_back(chunk.corners.size());
+						}
+						chunk.corners.push_back(polygon[corner * 3 + element]);
+					}
+				}
+			}
+		}
+
+		void parseChunk(Chunk& chunk)
+		{
+			std::vector<int32_t> polygon{};
+			std::vector<uint8_t> polygonRelative{};
+			const char* line = chunk.begin;
+			while (line < chunk.end && chunk.error.empty())
+			{
+				const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', chunk.end - line));
+				const char* next = lineEnd != nullptr ? lineEnd + 1 : chunk.end;
+				if (lineEnd == nullptr) lineEnd = chunk.end;
+				if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+
+				const char* p = skipSpaces(line, lineEnd);
+				if (lineEnd - p >= 2 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+				{
+					// a position, optionally followed by a colour
+					float values[6];
+					p += 2;
+					size_t count = parseFloats(p, lineEnd, values, 6);
+					if (count < 3)
+					{
+						chunk.error = "bad vertex";
+						break;
+					}
+					chunk.positions.insert(chunk.positions.end(), values, values + 3);
+					if (count == 6)
+					{
+						chunk.colors.insert(chunk.colors.end(), values + 3, values + 6);
+					}
+					else
+					{
+						chunk.colors.insert(chunk.colors.end(), { 1.0f, 1.0f, 1.0f });
+					}
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 'n')
+				{
+					float values[3];
+					p += 2;
+					if (parseFloats(p, lineEnd, values, 3) < 3)
+					{
+						chunk.error = "bad normal";
+						break;
+					}
+					chunk.normals.insert(chunk.normals.end(), values, values + 3);
+				}
+				else if (lineEnd - p >= 3 && p[0] == 'v' && p[1] == 't')
+				{
+					// a third w coordinate is allowed, but nothing uses it
+					float values[3];
+					p += 2;
+					if (parseFloats(p, lineEnd, values, 3) < 2)
+					{
+						chunk.error = "bad texcoord";
+						break;
+					}
+					chunk.texcoords.insert(chunk.texcoords.end(), values, values + 2);
+				}
+				else if (lineEnd - p >= 2 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+				{
+					parseFace(p + 2, lineEnd, chunk, polygon, polygonRelative);
+				}
+				line = next;
+			}
+		}
+
+		void throwIfFailed(const Chunk& chunk, const std::string& filepath)
+		{
+			if (!chunk.error.empty())
+			{
+				throw std::runtime_error(chunk.error + " in OBJ file: " + filepath);
+			}
+		}
+
+		// splits the file into about chunkCount pieces, moving each split to just after a line break
+		std::vector<Chunk> splitIntoChunks(const char* data, size_t size, size_t chunkCount)
+		{
+			std::vector<Chunk> chunks(chunkCount);
+			const char* end = data + size;
+			const char* begin = data;
+			for (size_t i = 0; i < chunkCount; i++)
+			{
+				const char* split = i + 1 == chunkCount ? end : std::max(begin, data + size * (i + 1) / chunkCount);
+				const char* lineBreak = split < end ? static_cast<const char*>(std::memchr(split, '\n', end - split)) : nullptr;
+				split = lineBreak != nullptr ? lineBreak + 1 : end;
+				chunks[i].begin = begin;
+				chunks[i].end = split;
+				begin = split;
+			}
+			return chunks;
+		}
+	}
+
+	void LveObjReader::read(const std::string& filepath, LveModel::Builder& builder, LveThreadPool& threadPool)
+	{
+		LveMappedFile file{};
+		if (!file.open(filepath))
+		{
+			throw std::runtime_error("failed to open OBJ file: " + filepath);
+		}
+		const char* data = reinterpret_cast<const char*>(file.data());
+		size_t size = file.getSize();
+
+		size_t chunkCount = std::clamp<size_t>(size / MIN_CHUNK_SIZE, 1, threadPool.getConcurrency());
+		std::vector<Chunk> chunks = splitIntoChunks(data, size, chunkCount);
+		threadPool.parallelFor(chunks.size(), 1, [&chunks](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				parseChunk(chunks[i]);
+			}
+		});
+
+		// where each chunk's elements start once they're all put together
+		std::vector<size_t> positionBase(chunks.size());
+		std::vector<size_t> texcoordBase(chunks.size());
+		std::vector<size_t> normalBase(chunks.size());
+		size_t positionCount = 0;
+		size_t texcoordCount = 0;
+		size_t normalCount = 0;
+		size_t cornerCount = 0;
+		for (size_t i = 0; i < chunks.size(); i++)
+		{
+			throwIfFailed(chunks[i], filepath);
+			positionBase[i] = positionCount;
+			texcoordBase[i] = texcoordCount;
+			normalBase[i] = normalCount;
+			positionCount += chunks[i].positions.size() / 3;
+			texcoordCount += chunks[i].texcoords.size() / 2;
+			normalCount += chunks[i].normals.size() / 3;
+			cornerCount += chunks[i].corners.size() / 3;
+		}
+
+		std::vector<float> positions(positionCount * 3);
+		std::vector<float> colors(positionCount * 3);
+		std::vector<float> texcoords(texcoordCount * 2);
+		std::vector<float> normals(normalCount * 3);
+		threadPool.parallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++)
+			{
+				Chunk& chunk = chunks[i];
+				std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + positionBase[i] * 3);
+				std::copy(chunk.colors.begin(), chunk.colors.end(), colors.begin() + positionBase[i] * 3);
+				std::copy(chunk.texcoords.begin(), chunk.texcoords.end(), texcoords.begin() + texcoordBase[i] * 2);
+				std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + normalBase[i] * 3);
+
+				size_t bases[3] = { positionBase[i], texcoordBase[i], normalBase[i] };
+				for (size_t corner : chunk.relativeCorners)
+				{
+					chunk.corners[corner] += static_cast<int32_t>(bases[corner % 3]);
+					// -1 would read as a missing texcoord or normal
+					if (chunk.corners[corner] < 0)
+					{
+						chunk.error = "relative index before the start of the file";
+					}
+				}
+			}
+		});
+
+		for (const Chunk& chunk : chunks)
+		{
+			throwIfFailed(chunk, filepath);
+		}
+		if (cornerCount > UINT32_MAX)
+		{
+			throw std::runtime_error("too many faces in OBJ file: " + filepath);
+		}
+
+		builder.vertices.clear();
+		builder.indices.clear();
+		builder.indices.reserve(cornerCount);
+		builder.vertices.reserve(positionCount);
+
+		// in file order, so vertices come out numbered the same way whatever the chunking was
+		LveVertexIndexMap uniqueVertices{ cornerCount };
+		for (const Chunk& chunk : chunks)
+		{
+			for (size_t i = 0; i < chunk.corners.size(); i += 3)
+			{
+				int32_t position = chunk.corners[i];
+				int32_t texcoord = chunk.corners[i + 1];
+				int32_t normal = chunk.corners[i + 2];
+				if (position < 0 || static_cast<size_t>(position) >= positionCount
+					|| texcoord >= static_cast<int32_t>(texcoordCount) || normal >= static_cast<int32_t>(normalCount))
+				{
+					throw std::runtime_error("face index out of range in OBJ file: " + filepath);
+				}
+
+				bool inserted;
+				builder.indices.push_back(uniqueVertices.findOrInsert(position, normal, texcoord,
+					static_cast<uint32_t>(builder.vertices.size()), inserted));
+				if (!inserted) continue;
+
+				LveModel::Vertex vertex{};
+				vertex.position = { positions[3 * position + 0], positions[3 * position + 1], positions[3 * position + 2] };
+				vertex.color = { colors[3 * position + 0], colors[3 * position + 1], colors[3 * position + 2] };
+				if (normal >= 0)
+				{
+					vertex.normal = { normals[3 * normal + 0], normals[3 * normal + 1], normals[3 * normal + 2] };
+				}
+				if (texcoord >= 0)
+				{
+					vertex.uv = { texcoords[2 * texcoord + 0], texcoords[2 * texcoord + 1] };
+				}
+				builder.vertices.push_back(vertex);
+			}
+		}
+	}
+} // namespace lve
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "lve_model.hpp"
+#include "lve_thread_pool.hpp"
+
+// std
+#include <cstddef>
+#include <string>
+
+namespace lve
+{
+	// Reads Wavefront OBJ files straight into a builder's vertex and index arrays.
+	// The file is memory mapped and split into line aligned chunks that are parsed on the thread pool (numbers
+	// go through std::from_chars), each into its own attribute arrays and face corners. The chunks are then
+	// stitched together, and one pass over the corners deduplicates them into the final vertices, so nothing
+	// goes through an intermediate mesh representation.
+	// Understands v (with the optional r g b vertex colour after the position, white without one), vt, vn and
+	// f with absolute or relative indices. Polygons are triangulated as fans. Everything else (objects, groups,
+	// materials, smoothing) is skipped, since the engine doesn't use it
+	class LveObjReader
+	{
+	public:
+		// files smaller than this are parsed on the calling thread only
+		static constexpr size_t MIN_CHUNK_SIZE = 256 * 1024;
+
+		// throws if the file can't be read or isn't valid OBJ
+		static void read(const std::string& filepath, LveModel::Builder& builder,
+			LveThreadPool& threadPool = LveThreadPool::global());
+	};
+} // namespace lve
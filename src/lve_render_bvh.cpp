@@ -0,0 +1,277 @@
+#include "lve_render_bvh.hpp"
+
+// std
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <utility>
+
+namespace lve
+{
+	LveRenderBvh::LveRenderBvh(LveThreadPool& threadPool) : LveRenderBvh(Settings{}, threadPool) {}
+
+	LveRenderBvh::LveRenderBvh(const Settings& settings, LveThreadPool& threadPool)
+		: settings{ settings }, threadPool{ threadPool } {}
+
+	void LveRenderBvh::update(const LveScene& scene)
+	{
+		if (scene.getRenderablesVersion() != builtVersion)
+		{
+			rebuild(scene);
+			return;
+		}
+
+		const RenderComponent* renderables = scene.renderables.data();
+		for (LveScene::Entity entity : scene.getMovedEntities())
+		{
+			if (entity.index >= objectOfSlot.size() || objectOfSlot[entity.index] == NONE) continue;
+
+			Object& object = objects[objectOfSlot[entity.index]];
+			renderables[object.renderable].model->getBounds().transformedBox(
+				scene.getWorldMatrix(entity), object.min, object.max);
+			refit(object.node);
+			movesSinceBuild++;
+		}
+
+		// refitting never splits anything, so once most objects have moved the boxes overlap a lot more than a
+		// fresh build's would
+		if (movesSinceBuild > objects.size())
+		{
+			rebuild(scene);
+		}
+	}
+
+	void LveRenderBvh::rebuild(const LveScene& scene)
+	{
+		builtVersion = scene.getRenderablesVersion();
+		movesSinceBuild = 0;
+		nodes.clear();
+		objects.clear();
+		std::fill(objectOfSlot.begin(), objectOfSlot.end(), NONE);
+
+		const RenderComponent* renderables = scene.renderables.data();
+		for (size_t i = 0; i < scene.renderables.size(); i++)
+		{
+			if (renderables[i].model == nullptr) continue;
+			Object object{};
+			object.renderable = static_cast<uint32_t>(i);
+			renderables[i].model->getBounds().transformedBox(
+				scene.getWorldMatrix(scene.renderables.entityAt(i)), object.min, object.max);
+			objects.push_back(object);
+		}
+		if (objects.empty()) return;
+
+		// median splits never leave a leaf with fewer than two objects, so there are fewer nodes than objects
+		nodes.reserve(objects.size());
+		nodes.emplace_back();
+		build(0, 0, static_cast<uint32_t>(objects.size()), NONE);
+
+		for (uint32_t i = 0; i < objects.size(); i++)
+		{
+			LveScene::Entity entity = scene.renderables.entityAt(objects[i].renderable);
+			if (entity.index >= objectOfSlot.size())
+			{
+				objectOfSlot.resize(entity.index + 1, NONE);
+			}
+			objectOfSlot[entity.index] = i;
+		}
+	}
+
+	void LveRenderBvh::build(uint32_t index, uint32_t begin, uint32_t end, uint32_t parent)
+	{
+		Node& node = nodes[index];
+		node.firstObject = begin;
+		node.objectCount = end - begin;
+		node.left = NONE;
+		node.parent = parent;
+		computeNodeBounds(node);
+
+		if (end - begin <= MAX_LEAF_OBJECTS)
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				objects[i].node = index;
+			}
+			return;
+		}
+
+		// median split along the axis the centers are most spread out on. Not as tight as a SAH build, but it's
+		// O(n log n) and balanced, which is what matters when streaming rebuilds it
+		glm::vec3 centerMin = objects[begin].min + objects[begin].max;
+		glm::vec3 centerMax = centerMin;
+		for (uint32_t i = begin + 1; i < end; i++)
+		{
+			glm::vec3 center = objects[i].min + objects[i].max;
+			centerMin = glm::min(centerMin, center);
+			centerMax = glm::max(centerMax, center);
+		}
+		glm::vec3 spread = centerMax - centerMin;
+		int axis = spread.x > spread.y ? (spread.x > spread.z ? 0 : 2) : (spread.y > spread.z ? 1 : 2);
+
+		uint32_t middle = begin + (end - begin) / 2;
+		std::nth_element(objects.begin() + begin, objects.begin() + middle, objects.begin() + end,
+			[axis](const Object& a, const Object& b) { return a.min[axis] + a.max[axis] < b.min[axis] + b.max[axis]; });
+
+		// both children go in side by side so the right one is always left + 1
+		uint32_t left = static_cast<uint32_t>(nodes.size());
+		nodes[index].left = left;
+		nodes.emplace_back();
+		nodes.emplace_back();
+		build(left, begin, middle, index);
+		build(left + 1, middle, end, index);
+	}
+
+	void LveRenderBvh::computeNodeBounds(Node& node) const
+	{
+		node.min = objects[node.firstObject].min;
+		node.max = objects[node.firstObject].max;
+		for (uint32_t i = node.firstObject + 1; i < node.firstObject + node.objectCount; i++)
+		{
+			node.min = glm::min(node.min, objects[i].min);
+			node.max = glm::max(node.max, objects[i].max);
+		}
+	}
+
+	void LveRenderBvh::refit(uint32_t index)
+	{
+		computeNodeBounds(nodes[index]);
+		index = nodes[index].parent;
+		while (index != NONE)
+		{
+			Node& node = nodes[index];
+			const Node& left = nodes[node.left];
+			const Node& right = nodes[node.left + 1];
+			glm::vec3 min = glm::min(left.min, right.min);
+			glm::vec3 max = glm::max(left.max, right.max);
+			// anything above an unchanged box is unchanged too
+			if (min == node.min && max == node.max) break;
+			node.min = min;
+			node.max = max;
+			index = node.parent;
+		}
+	}
+
+	bool LveRenderBvh::testBox(const glm::vec3& min, const glm::vec3& max, const CullContext& context, uint8_t& flags)
+	{
+		if (!(flags & IN_RANGE))
+		{
+			// nearest and furthest points of the box from the camera
+			glm::vec3 nearest = glm::max(glm::max(min - context.cameraPosition, context.cameraPosition - max), glm::vec3{ 0.0f });
+			if (glm::dot(nearest, nearest) > context.maxDistanceSquared) return false;
+			glm::vec3 furthest = glm::max(glm::abs(min - context.cameraPosition), glm::abs(max - context.cameraPosition));
+			if (glm::dot(furthest, furthest) <= context.maxDistanceSquared) flags |= IN_RANGE;
+		}
+		if (!(flags & IN_FRUSTUM))
+		{
+			LveFrustum::Containment containment = context.frustum.classifyBox(min, max);
+			if (containment == LveFrustum::Containment::OUTSIDE) return false;
+			if (containment == LveFrustum::Containment::INSIDE) flags |= IN_FRUSTUM;
+		}
+		return true;
+	}
+
+	void LveRenderBvh::acceptObjects(uint32_t first, uint32_t count, const CullContext& context, CullCounts& counts) const
+	{
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			uint32_t renderable = objects[i].renderable;
+			if (context.renderables[renderable].isVisible)
+			{
+				context.visible[renderable] = 1;
+				counts.drawn++;
+			}
+			else
+			{
+				counts.hidden++;
+			}
+		}
+	}
+
+	void LveRenderBvh::cullNode(uint32_t index, uint8_t flags, const CullContext& context, CullCounts& counts) const
+	{
+		const Node& node = nodes[index];
+		if (!testBox(node.min, node.max, context, flags)) return;
+
+		if (flags == ACCEPTED)
+		{
+			acceptObjects(node.firstObject, node.objectCount, context, counts);
+		}
+		else if (node.left == NONE)
+		{
+			for (uint32_t i = node.firstObject; i < node.firstObject + node.objectCount; i++)
+			{
+				uint8_t objectFlags = flags;
+				if (testBox(objects[i].min, objects[i].max, context, objectFlags))
+				{
+					acceptObjects(i, 1, context, counts);
+				}
+			}
+		}
+		else
+		{
+			cullNode(node.left, flags, context, counts);
+			cullNode(node.left + 1, flags, context, counts);
+		}
+	}
+
+	void LveRenderBvh::cull(const LveScene& scene, const LveFrustum& frustum, const glm::vec3& cameraPosition,
+		LveVisibleSet& visibleSet) const
+	{
+		visibleSet.visible.assign(scene.renderables.size(), 0);
+		visibleSet.drawn = 0;
+		visibleSet.culled = 0;
+		if (nodes.empty()) return;
+
+		float maxDistanceSquared = settings.maxDistance < std::sqrt(std::numeric_limits<float>::max())
+			? settings.maxDistance * settings.maxDistance : std::numeric_limits<float>::max();
+		CullContext context{ frustum, cameraPosition, maxDistanceSquared, scene.renderables.data(), visibleSet.visible.data() };
+		CullCounts counts{};
+
+		if (objects.size() < settings.parallelThreshold)
+		{
+			cullNode(0, 0, context, counts);
+		}
+		else
+		{
+			// split the top of the tree into a few subtrees per thread, testing the nodes on the way down so
+			// rejected ones are never handed out. Subtrees that are accepted whole are cheap, so there are
+			// several per thread to even out the work
+			size_t targetSubtrees = static_cast<size_t>(threadPool.getConcurrency()) * 4;
+			std::deque<std::pair<uint32_t, uint8_t>> open{ { 0u, uint8_t{ 0 } } };
+			std::vector<std::pair<uint32_t, uint8_t>> subtrees{};
+			while (!open.empty() && open.size() + subtrees.size() < targetSubtrees)
+			{
+				auto [index, flags] = open.front();
+				open.pop_front();
+				const Node& node = nodes[index];
+				if (node.left == NONE || flags == ACCEPTED)
+				{
+					subtrees.emplace_back(index, flags);
+					continue;
+				}
+				if (!testBox(node.min, node.max, context, flags)) continue;
+				open.emplace_back(node.left, flags);
+				open.emplace_back(node.left + 1, flags);
+			}
+			subtrees.insert(subtrees.end(), open.begin(), open.end());
+
+			std::atomic<uint32_t> drawn{ 0 };
+			std::atomic<uint32_t> hidden{ 0 };
+			threadPool.parallelFor(subtrees.size(), 1, [&](size_t begin, size_t end) {
+				CullCounts localCounts{};
+				for (size_t i = begin; i < end; i++)
+				{
+					cullNode(subtrees[i].first, subtrees[i].second, context, localCounts);
+				}
+				drawn += localCounts.drawn;
+				hidden += localCounts.hidden;
+			});
+			counts.drawn = drawn;
+			counts.hidden = hidden;
+		}
+
+		visibleSet.drawn = counts.drawn;
+		visibleSet.culled = static_cast<uint32_t>(objects.size()) - counts.drawn - counts.hidden;
+	}
+} // namespace lve
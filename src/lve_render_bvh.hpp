@@ -0,0 +1,123 @@
+#pragma once
+
+#include "lve_frustum.hpp"
+#include "lve_scene.hpp"
+#include "lve_thread_pool.hpp"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace lve
+{
+	// Bounding volume hierarchy over the world space boxes of the scene's renderables, used to cull them for
+	// drawing. It has nothing to do with the collision quad tree: it holds every mesh, including ones that have
+	// no colliders, and it's rebuilt and refit around what the renderer needs.
+	// Whole subtrees are rejected when their box is outside the frustum or beyond the distance cutoff, and
+	// accepted without any more tests once a box is completely inside both, so the cost follows what's near the
+	// edges of the view rather than the size of the scene. Large scenes are split into subtrees culled in
+	// parallel on the thread pool.
+	// Objects that move are refit in place (their leaf and its ancestors only). Adding or removing renderables
+	// rebuilds the tree, as does a lot of accumulated movement, since refitting slowly loosens the tree
+	class LveRenderBvh
+	{
+	public:
+		struct Settings
+		{
+			// objects further than this from the camera (measured to the nearest point of their box) aren't drawn
+			float maxDistance = std::numeric_limits<float>::max();
+			// scenes with fewer renderables than this are culled on the calling thread only
+			size_t parallelThreshold = 8192;
+		};
+
+		explicit LveRenderBvh(LveThreadPool& threadPool = LveThreadPool::global());
+		LveRenderBvh(const Settings& settings, LveThreadPool& threadPool = LveThreadPool::global());
+
+		LveRenderBvh(const LveRenderBvh&) = delete;
+		LveRenderBvh& operator=(const LveRenderBvh&) = delete;
+
+		// call once a frame after LveScene::updateWorldMatrices, since it picks up moved objects from that call
+		void update(const LveScene& scene);
+		// fills the visible set the same way LveScene::cullRenderables does. Hidden objects in view count as
+		// neither drawn nor culled, hidden objects out of view count as culled
+		void cull(const LveScene& scene, const LveFrustum& frustum, const glm::vec3& cameraPosition,
+			LveVisibleSet& visibleSet) const;
+
+		void setSettings(const Settings& newSettings) { settings = newSettings; }
+		const Settings& getSettings() const { return settings; }
+		size_t getNodeCount() const { return nodes.size(); }
+		size_t getObjectCount() const { return objects.size(); }
+
+	private:
+		static constexpr uint32_t NONE = ~0u;
+		static constexpr uint32_t MAX_LEAF_OBJECTS = 4;
+
+		// flags for what a node's box is already known to be entirely within, so its subtree can skip that test
+		static constexpr uint8_t IN_FRUSTUM = 1;
+		static constexpr uint8_t IN_RANGE = 2;
+		static constexpr uint8_t ACCEPTED = IN_FRUSTUM | IN_RANGE;
+
+		// every node covers a contiguous range of objects, so a subtree that's accepted whole is a flat loop
+		struct Node
+		{
+			glm::vec3 min;
+			uint32_t firstObject;
+			glm::vec3 max;
+			uint32_t objectCount;
+			// the right child is always left + 1. NONE for leaves
+			uint32_t left;
+			uint32_t parent;
+		};
+
+		struct Object
+		{
+			glm::vec3 min;
+			// dense index into the scene's renderables
+			uint32_t renderable;
+			glm::vec3 max;
+			// leaf holding this object
+			uint32_t node;
+		};
+
+		struct CullContext
+		{
+			const LveFrustum& frustum;
+			glm::vec3 cameraPosition;
+			float maxDistanceSquared;
+			const RenderComponent* renderables;
+			uint8_t* visible;
+		};
+
+		struct CullCounts
+		{
+			uint32_t drawn = 0;
+			uint32_t hidden = 0;
+		};
+
+		void rebuild(const LveScene& scene);
+		// fills in nodes[index] for objects [begin, end) and builds its subtree
+		void build(uint32_t index, uint32_t begin, uint32_t end, uint32_t parent);
+		void computeNodeBounds(Node& node) const;
+		void refit(uint32_t node);
+
+		// returns false if the box can be rejected, and adds to flags whatever the box is entirely within
+		static bool testBox(const glm::vec3& min, const glm::vec3& max, const CullContext& context, uint8_t& flags);
+		void cullNode(uint32_t node, uint8_t flags, const CullContext& context, CullCounts& counts) const;
+		void acceptObjects(uint32_t first, uint32_t count, const CullContext& context, CullCounts& counts) const;
+
+		Settings settings;
+		LveThreadPool& threadPool;
+
+		std::vector<Node> nodes;
+		std::vector<Object> objects;
+		// entity slot -> object, NONE for entities that aren't renderables
+		std::vector<uint32_t> objectOfSlot;
+		uint64_t builtVersion = std::numeric_limits<uint64_t>::max();
+		size_t movesSinceBuild = 0;
+	};
+} // namespace lve
@@ -0,0 +1,110 @@
+#include "lve_render_queue.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+
+namespace lve
+{
+	namespace
+	{
+		// non-negative floats compare the same way as their bit patterns, so depth can go straight into a key
+		uint32_t depthBits(float depth)
+		{
+			depth = std::max(depth, 0.0f);
+			uint32_t bits;
+			std::memcpy(&bits, &depth, sizeof(bits));
+			return bits;
+		}
+	}
+
+	uint64_t LveRenderQueue::opaqueKey(Pass pass, uint32_t modelId, float depth)
+	{
+		// 28 bits of model id, which is plenty to keep models apart within one frame
+		return static_cast<uint64_t>(pass) << PASS_SHIFT
+			| static_cast<uint64_t>(modelId & 0x0fffffffu) << MODEL_SHIFT
+			| depthBits(depth);
+	}
+
+	uint64_t LveRenderQueue::blendedKey(float depth, uint32_t modelId)
+	{
+		// furthest first, with the model only breaking ties
+		return static_cast<uint64_t>(Pass::ALPHA_BLENDED) << PASS_SHIFT
+			| static_cast<uint64_t>(~depthBits(depth)) << 28
+			| (modelId & 0x0fffffffu);
+	}
+
+	void LveRenderQueue::push(uint64_t key, const DrawPacket& packet)
+	{
+		keys.emplace_back(key, static_cast<uint32_t>(unsorted.size()));
+		unsorted.push_back(packet);
+	}
+
+	void LveRenderQueue::build(const LveScene& scene, const LveVisibleSet& visibleSet, const LveCamera& camera)
+	{
+		unsorted.clear();
+		keys.clear();
+
+		// depth along the view direction, which is the third row of the view matrix
+		const glm::mat4& view = camera.getView();
+		glm::vec4 depthRow{ view[0][2], view[1][2], view[2][2], view[3][2] };
+
+		const RenderComponent* objects = scene.renderables.data();
+		for (size_t i = 0; i < scene.renderables.size(); i++)
+		{
+			if (!visibleSet.contains(i)) continue;
+
+			const RenderComponent& obj = objects[i];
+			LveScene::Entity entity = scene.renderables.entityAt(i);
+			DrawPacket packet{};
+			packet.modelMatrix = scene.getWorldMatrix(entity);
+			packet.normalMatrix = glm::mat4{ scene.getWorldNormalMatrix(entity) };
+			packet.model = obj.model.get();
+			packet.specular = obj.specular;
+			packet.alpha = obj.alpha;
+
+			float depth = glm::dot(depthRow, packet.modelMatrix[3]);
+			uint32_t modelId = obj.model->getId();
+			if (obj.alpha < 1.0f)
+			{
+				push(blendedKey(depth, modelId), packet);
+			}
+			else
+			{
+				Pass pass = obj.materialId == GOLFTURF_MATERIAL ? Pass::GOLFTURF : Pass::SIMPLE;
+				push(opaqueKey(pass, modelId, depth), packet);
+			}
+
+			if (scene.outlines.has(entity))
+			{
+				push(opaqueKey(Pass::OUTLINE, modelId, depth), packet);
+			}
+		}
+
+		std::sort(keys.begin(), keys.end());
+
+		packets.resize(keys.size());
+		for (size_t i = 0; i < keys.size(); i++)
+		{
+			packets[i] = unsorted[keys[i].second];
+		}
+
+		// the pass is the top bits, so each one starts where the previous one ends
+		size_t offset = 0;
+		for (size_t pass = 0; pass <= static_cast<size_t>(Pass::COUNT); pass++)
+		{
+			while (offset < keys.size() && (keys[offset].first >> PASS_SHIFT) < pass)
+			{
+				offset++;
+			}
+			passOffsets[pass] = offset;
+		}
+	}
+
+	LveRenderQueue::Slice LveRenderQueue::getPass(Pass pass) const
+	{
+		size_t begin = passOffsets[static_cast<size_t>(pass)];
+		size_t end = passOffsets[static_cast<size_t>(pass) + 1];
+		return Slice{ packets.data() + begin, end - begin };
+	}
+} // namespace lve
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "lve_camera.hpp"
+#include "lve_model.hpp"
+#include "lve_scene.hpp"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace lve
+{
+	// Everything the mesh passes draw this frame, built once from the culled scene and sorted so each pass reads
+	// one contiguous slice in the order that needs the fewest rebinds.
+	// Each packet has a 64-bit key: the pass in the top bits (every pass is one pipeline), then for opaque passes
+	// the model (so every object sharing a vertex buffer is drawn back to back) and the view depth front to
+	// back, and for the blended pass the depth back to front, since that order is needed for blending to
+	// come out right
+	class LveRenderQueue
+	{
+	public:
+		enum class Pass : uint8_t
+		{
+			SIMPLE,
+			GOLFTURF,
+			OUTLINE,
+			// objects with alpha below 1. Takes them out of their material's pass
+			ALPHA_BLENDED,
+			COUNT,
+		};
+
+		// the material id the golf turf pass draws, everything else opaque goes through the simple pass
+		static constexpr int GOLFTURF_MATERIAL = 1;
+
+		struct DrawPacket
+		{
+			glm::mat4 modelMatrix;
+			glm::mat4 normalMatrix;
+			LveModel* model;
+			float specular;
+			float alpha;
+		};
+
+		struct Slice
+		{
+			const DrawPacket* packets;
+			size_t count;
+
+			const DrawPacket* begin() const { return packets; }
+			const DrawPacket* end() const { return packets + count; }
+			bool empty() const { return count == 0; }
+		};
+
+		// call after culling. Only objects in the visible set are queued
+		void build(const LveScene& scene, const LveVisibleSet& visibleSet, const LveCamera& camera);
+
+		Slice getPass(Pass pass) const;
+		size_t size() const { return packets.size(); }
+
+	private:
+		static constexpr int PASS_SHIFT = 60;
+		static constexpr int MODEL_SHIFT = 32;
+
+		static uint64_t opaqueKey(Pass pass, uint32_t modelId, float depth);
+		static uint64_t blendedKey(float depth, uint32_t modelId);
+
+		void push(uint64_t key, const DrawPacket& packet);
+
+		// packets in the order they were queued, then (key, index into unsorted) sorted by key
+		std::vector<DrawPacket> unsorted;
+		std::vector<std::pair<uint64_t, uint32_t>> keys;
+		std::vector<DrawPacket> packets;
+		std::array<size_t, static_cast<size_t>(Pass::COUNT) + 1> passOffsets{};
+	};
+} // namespace lve
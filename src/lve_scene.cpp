@@ -0,0 +1,320 @@
+#include "lve_scene.hpp"
+
+// std
+#include <algorithm>
+
+namespace lve
+{
+	LveScene::Entity LveScene::create()
+	{
+		Entity entity{};
+		if (!freeSlots.empty())
+		{
+			entity.index = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		else
+		{
+			entity.index = static_cast<uint32_t>(generations.size());
+			generations.push_back(0);
+		}
+		entity.generation = generations[entity.index];
+		return entity;
+	}
+
+	LveScene::Entity LveScene::add(LveGameObject&& object, const std::string& name, Entity parent)
+	{
+		Entity entity = create();
+		if (!name.empty())
+		{
+			assert(names.count(name) == 0 && "Scene object names have to be unique");
+			names[name] = entity;
+		}
+
+		transforms.add(entity, object.transform);
+
+		// new objects start out as roots at the end of the hierarchy
+		if (entity.index >= nodeIndices.size())
+		{
+			nodeIndices.resize(entity.index + 1, NONE);
+		}
+		nodeIndices[entity.index] = static_cast<uint32_t>(hierarchy.size());
+		hierarchy.push_back(HierarchyNode{ entity, Entity{}, NONE, 1, 0, true });
+		worldMatrices.push_back(glm::mat4{ 1.0f });
+		worldNormalMatrices.push_back(glm::mat3{ 1.0f });
+		if (!parent.isNull())
+		{
+			setParent(entity, parent);
+		}
+
+		if (object.model != nullptr)
+		{
+			RenderComponent render{};
+			render.model = std::move(object.model);
+			render.color = object.color;
+			render.materialId = object.materialId;
+			render.specular = object.specular;
+			render.alpha = object.alpha;
+			render.isVisible = object.isVisible;
+			renderables.add(entity, std::move(render));
+			renderablesVersion++;
+
+			if (object.outline)
+			{
+				outlines.add(entity);
+			}
+		}
+
+		if (object.pointLight != nullptr)
+		{
+			PointLightComponent light = *object.pointLight;
+			light.color = object.color;
+			pointLights.add(entity, light);
+		}
+
+		return entity;
+	}
+
+	void LveScene::remove(Entity entity)
+	{
+		if (!isValid(entity)) return;
+
+		if (entity.index >= nodeIndices.size() || nodeIndices[entity.index] == NONE)
+		{
+			// made with create() and never added, so it has no components or children
+			retire(entity);
+			return;
+		}
+
+		// the whole subtree goes, and it's contiguous
+		uint32_t begin = hierarchyIndex(entity);
+		uint32_t count = hierarchy[begin].subtreeSize;
+		if (hierarchy[begin].parentIndex != NONE)
+		{
+			updateSubtreeSizes(hierarchy[begin].parentIndex, -static_cast<int>(count));
+		}
+
+		std::vector<Entity> removed{};
+		for (uint32_t i = begin; i < begin + count; i++)
+		{
+			removed.push_back(hierarchy[i].entity);
+			nodeIndices[hierarchy[i].entity.index] = NONE;
+		}
+		hierarchy.erase(hierarchy.begin() + begin, hierarchy.begin() + begin + count);
+		worldMatrices.erase(worldMatrices.begin() + begin, worldMatrices.begin() + begin + count);
+		worldNormalMatrices.erase(worldNormalMatrices.begin() + begin, worldNormalMatrices.begin() + begin + count);
+		rebuildNodeIndices();
+
+		for (Entity child : removed)
+		{
+			retire(child);
+		}
+	}
+
+	void LveScene::retire(Entity entity)
+	{
+		transforms.remove(entity);
+		if (renderables.has(entity))
+		{
+			renderables.remove(entity);
+			renderablesVersion++;
+		}
+		outlines.remove(entity);
+		pointLights.remove(entity);
+
+		// any handle still pointing at this slot is stale from here on
+		generations[entity.index]++;
+		freeSlots.push_back(entity.index);
+
+		for (auto it = names.begin(); it != names.end(); ++it)
+		{
+			if (it->second == entity)
+			{
+				names.erase(it);
+				break;
+			}
+		}
+	}
+
+	void LveScene::clear()
+	{
+		transforms.clear();
+		renderables.clear();
+		renderablesVersion++;
+		outlines.clear();
+		pointLights.clear();
+
+		hierarchy.clear();
+		worldMatrices.clear();
+		worldNormalMatrices.clear();
+		nodeIndices.clear();
+
+		// keep the generations so handles from before the clear stay stale
+		freeSlots.clear();
+		for (uint32_t i = static_cast<uint32_t>(generations.size()); i > 0; i--)
+		{
+			generations[i - 1]++;
+			freeSlots.push_back(i - 1);
+		}
+		names.clear();
+	}
+
+	void LveScene::setParent(Entity child, Entity parent)
+	{
+		uint32_t begin = hierarchyIndex(child);
+		if (hierarchy[begin].parent == parent) return;
+
+		uint32_t count = hierarchy[begin].subtreeSize;
+		// the subtree goes right after the end of the new parent's subtree, or at the very end for roots
+		uint32_t to = static_cast<uint32_t>(hierarchy.size());
+		if (!parent.isNull())
+		{
+			uint32_t parentIndex = hierarchyIndex(parent);
+			if (parentIndex >= begin && parentIndex < begin + count)
+			{
+				assert(false && "Can't parent an object to itself or one of its descendants");
+				return;
+			}
+			to = parentIndex + hierarchy[parentIndex].subtreeSize;
+		}
+
+		if (hierarchy[begin].parentIndex != NONE)
+		{
+			updateSubtreeSizes(hierarchy[begin].parentIndex, -static_cast<int>(count));
+		}
+		hierarchy[begin].parent = parent;
+		moveNodes(begin, count, to);
+		rebuildNodeIndices();
+
+		begin = hierarchyIndex(child);
+		if (!parent.isNull())
+		{
+			updateSubtreeSizes(hierarchyIndex(parent), static_cast<int>(count));
+		}
+		for (uint32_t i = begin; i < begin + count; i++)
+		{
+			hierarchy[i].stale = true;
+		}
+	}
+
+	LveScene::Entity LveScene::getParent(Entity entity) const
+	{
+		return hierarchy[hierarchyIndex(entity)].parent;
+	}
+
+	void LveScene::updateWorldMatrices()
+	{
+		changed.resize(hierarchy.size());
+		movedEntities.clear();
+		for (size_t i = 0; i < hierarchy.size(); i++)
+		{
+			HierarchyNode& node = hierarchy[i];
+			TransformComponent& transform = transforms.get(node.entity);
+
+			// parents always come first, so their changed flag is already final
+			bool parentChanged = node.parentIndex != NONE && changed[node.parentIndex];
+			changed[i] = node.stale || parentChanged || transform.getVersion() != node.seenVersion;
+			if (!changed[i]) continue;
+
+			if (node.parentIndex == NONE)
+			{
+				worldMatrices[i] = transform.mat4();
+				worldNormalMatrices[i] = transform.normalMatrix();
+			}
+			else
+			{
+				worldMatrices[i] = worldMatrices[node.parentIndex] * transform.mat4();
+				worldNormalMatrices[i] = worldNormalMatrices[node.parentIndex] * transform.normalMatrix();
+			}
+			node.seenVersion = transform.getVersion();
+			node.stale = false;
+			movedEntities.push_back(node.entity);
+		}
+	}
+
+	void LveScene::moveNodes(uint32_t begin, uint32_t count, uint32_t to)
+	{
+		auto rotate = [&](auto& nodes) {
+			if (to > begin + count)
+			{
+				std::rotate(nodes.begin() + begin, nodes.begin() + begin + count, nodes.begin() + to);
+			}
+			else if (to < begin)
+			{
+				std::rotate(nodes.begin() + to, nodes.begin() + begin, nodes.begin() + begin + count);
+			}
+		};
+		rotate(hierarchy);
+		rotate(worldMatrices);
+		rotate(worldNormalMatrices);
+	}
+
+	void LveScene::updateSubtreeSizes(uint32_t index, int delta)
+	{
+		while (index != NONE)
+		{
+			hierarchy[index].subtreeSize += delta;
+			index = hierarchy[index].parentIndex;
+		}
+	}
+
+	void LveScene::rebuildNodeIndices()
+	{
+		for (size_t i = 0; i < hierarchy.size(); i++)
+		{
+			nodeIndices[hierarchy[i].entity.index] = static_cast<uint32_t>(i);
+		}
+		for (HierarchyNode& node : hierarchy)
+		{
+			node.parentIndex = node.parent.isNull() ? NONE : nodeIndices[node.parent.index];
+		}
+	}
+
+	void LveScene::cullRenderables(const LveFrustum& frustum, LveVisibleSet& visibleSet) const
+	{
+		visibleSet.visible.assign(renderables.size(), 0);
+		visibleSet.drawn = 0;
+		visibleSet.culled = 0;
+
+		const RenderComponent* objects = renderables.data();
+		for (size_t i = 0; i < renderables.size(); i++)
+		{
+			if (objects[i].model == nullptr || !objects[i].isVisible) continue;
+
+			const LveModel::Bounds& bounds = objects[i].model->getBounds();
+			const glm::mat4& world = worldMatrices[hierarchyIndex(renderables.entityAt(i))];
+			glm::vec3 center{ world * glm::vec4{ bounds.center, 1.0f } };
+
+			// the largest axis scale keeps the sphere conservative under non-uniform scale
+			float scale = glm::sqrt(glm::max(glm::max(
+				glm::dot(glm::vec3{ world[0] }, glm::vec3{ world[0] }),
+				glm::dot(glm::vec3{ world[1] }, glm::vec3{ world[1] })),
+				glm::dot(glm::vec3{ world[2] }, glm::vec3{ world[2] })));
+			float radius = bounds.radius * scale;
+
+			bool inside = frustum.intersectsSphere(center, radius);
+			if (inside && !frustum.containsSphere(center, radius))
+			{
+				glm::vec3 boxMin, boxMax;
+				bounds.transformedBox(world, boxMin, boxMax);
+				inside = frustum.intersectsBox(boxMin, boxMax);
+			}
+
+			if (inside)
+			{
+				visibleSet.visible[i] = 1;
+				visibleSet.drawn++;
+			}
+			else
+			{
+				visibleSet.culled++;
+			}
+		}
+	}
+
+	LveScene::Entity LveScene::find(const std::string& name) const
+	{
+		auto it = names.find(name);
+		return it != names.end() ? it->second : Entity{};
+	}
+} // namespace lve
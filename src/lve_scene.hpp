@@ -0,0 +1,255 @@
+#pragma once
+
+#include "lve_frustum.hpp"
+#include "lve_game_object.hpp"
+#include "lve_model.hpp"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace lve
+{
+	// Generational handle to an object in an LveScene. The index picks a slot, and the generation has to match
+	// the slot's current generation, so a handle to a removed object can't quietly point at whatever reused its slot
+	struct LveEntity
+	{
+		static constexpr uint32_t NULL_INDEX = ~0u;
+
+		uint32_t index = NULL_INDEX;
+		uint32_t generation = 0;
+
+		bool isNull() const { return index == NULL_INDEX; }
+		bool operator==(const LveEntity& other) const { return index == other.index && generation == other.generation; }
+		bool operator!=(const LveEntity& other) const { return !(*this == other); }
+	};
+
+	// Sparse set of one component type. The components themselves are packed into one contiguous array, so
+	// a system that only cares about (say) lights walks a dense array of lights and nothing else.
+	// Lookup by entity goes through the sparse array: two array reads, no hashing. The dense side keeps the full
+	// handle, so stale handles fail has() just like missing components do.
+	// Removing swaps the last component into the hole, so references into the pool don't survive adds or removes
+	template <typename T>
+	class LveComponentPool
+	{
+	public:
+		using Entity = LveEntity;
+
+		T& add(Entity entity, T component = T{})
+		{
+			assert(!entity.isNull() && !has(entity) && "Entity already has this component");
+			if (entity.index >= sparse.size())
+			{
+				sparse.resize(entity.index + 1, INVALID);
+			}
+			if (sparse[entity.index] != INVALID)
+			{
+				// left over from an older entity in the same slot
+				remove(denseEntities[sparse[entity.index]]);
+			}
+			sparse[entity.index] = static_cast<uint32_t>(dense.size());
+			denseEntities.push_back(entity);
+			dense.push_back(std::move(component));
+			return dense.back();
+		}
+
+		void remove(Entity entity)
+		{
+			if (!has(entity)) return;
+
+			uint32_t index = sparse[entity.index];
+			Entity last = denseEntities.back();
+			dense[index] = std::move(dense.back());
+			denseEntities[index] = last;
+			sparse[last.index] = index;
+
+			dense.pop_back();
+			denseEntities.pop_back();
+			sparse[entity.index] = INVALID;
+		}
+
+		bool has(Entity entity) const
+		{
+			return entity.index < sparse.size()
+				&& sparse[entity.index] != INVALID
+				&& denseEntities[sparse[entity.index]].generation == entity.generation;
+		}
+
+		T& get(Entity entity)
+		{
+			assert(has(entity) && "Entity doesn't have this component (or the handle is stale)");
+			return dense[sparse[entity.index]];
+		}
+
+		T* tryGet(Entity entity)
+		{
+			return has(entity) ? &dense[sparse[entity.index]] : nullptr;
+		}
+
+		void clear()
+		{
+			sparse.clear();
+			dense.clear();
+			denseEntities.clear();
+		}
+
+		size_t size() const { return dense.size(); }
+		T* data() { return dense.data(); }
+		const T* data() const { return dense.data(); }
+		// dense index of the entity's component, which is only good until the next add or remove
+		size_t indexOf(Entity entity) const
+		{
+			assert(has(entity) && "Entity doesn't have this component (or the handle is stale)");
+			return sparse[entity.index];
+		}
+
+		// the entity owning the component at a dense index
+		Entity entityAt(size_t index) const { return denseEntities[index]; }
+		const std::vector<Entity>& entities() const { return denseEntities; }
+
+		typename std::vector<T>::iterator begin() { return dense.begin(); }
+		typename std::vector<T>::iterator end() { return dense.end(); }
+
+	private:
+		static constexpr uint32_t INVALID = ~0u;
+
+		std::vector<uint32_t> sparse;
+		std::vector<T> dense;
+		std::vector<Entity> denseEntities;
+	};
+
+	// everything the mesh render systems need, apart from the transform
+	struct RenderComponent
+	{
+		std::shared_ptr<LveModel> model{};
+		glm::vec3 color{};
+		int materialId = 0;
+		float specular = 0.0f;
+		float alpha = 1.0f;
+		bool isVisible = true;
+	};
+
+	// tag component for objects the outline pass draws
+	struct OutlineComponent {};
+
+	// Which renderables passed frustum culling this frame, by dense index into the scene's renderables pool.
+	// Filled once a frame and shared by every pass that draws meshes, so nothing is tested twice
+	struct LveVisibleSet
+	{
+		std::vector<uint8_t> visible;
+		// visible objects with a model, and the ones of those that were outside the frustum
+		uint32_t drawn = 0;
+		uint32_t culled = 0;
+
+		bool contains(size_t renderableIndex) const { return visible[renderableIndex] != 0; }
+	};
+
+	// Dense component storage for everything in the world. Game objects are built as LveGameObjects and then
+	// added here, which splits them into one array per component type.
+	// Entities are generational handles into a slot array. Named objects can be looked up once at load time
+	// and the handle kept, so nothing on the hot path needs a hash lookup or a hard coded id.
+	// Objects can be parented to each other, in which case their transform is relative to the parent. The
+	// hierarchy is kept as one flat array in depth-first order (every parent before its subtree, and every
+	// subtree contiguous), so world matrices update in a single forward pass
+	class LveScene
+	{
+	public:
+		using Entity = LveEntity;
+
+		Entity create();
+		// moves the object's data into the component arrays and returns its entity. An empty name leaves it
+		// unnamed, and a null parent makes it a root
+		Entity add(LveGameObject&& object, const std::string& name = "", Entity parent = {});
+		// removes all components and retires the handle, along with everything parented under it.
+		// Does nothing for stale handles
+		void remove(Entity entity);
+		void clear();
+
+		// the child keeps its local transform, which is relative to the new parent from now on.
+		// A null parent makes it a root again. Meant for load time: it moves the subtree within the flat array
+		void setParent(Entity child, Entity parent);
+		Entity getParent(Entity entity) const;
+
+		// Recomputes world matrices for every object whose transform or any ancestor's transform changed since
+		// the last call. Call once per frame after gameplay has moved things and before rendering
+		void updateWorldMatrices();
+		const glm::mat4& getWorldMatrix(Entity entity) const { return worldMatrices[hierarchyIndex(entity)]; }
+		const glm::mat3& getWorldNormalMatrix(Entity entity) const { return worldNormalMatrices[hierarchyIndex(entity)]; }
+
+		// every entity whose world matrix changed in the last updateWorldMatrices call
+		const std::vector<Entity>& getMovedEntities() const { return movedEntities; }
+		// bumped whenever a renderable is added or removed, which also shuffles the dense indices. Swapping the
+		// model of an existing renderable doesn't count, so re-add the object instead if its bounds change
+		uint64_t getRenderablesVersion() const { return renderablesVersion; }
+
+		// tests every visible renderable's model bounds (at its world matrix) against the frustum: the sphere
+		// first, and the box only when the sphere straddles a plane. Call after updateWorldMatrices
+		void cullRenderables(const LveFrustum& frustum, LveVisibleSet& visibleSet) const;
+
+		bool isValid(Entity entity) const
+		{
+			return entity.index < generations.size() && generations[entity.index] == entity.generation;
+		}
+		// null handle if there's no object with that name
+		Entity find(const std::string& name) const;
+
+		size_t size() const { return transforms.size(); }
+
+		// every entity has a transform
+		LveComponentPool<TransformComponent> transforms;
+		LveComponentPool<RenderComponent> renderables;
+		LveComponentPool<OutlineComponent> outlines;
+		LveComponentPool<PointLightComponent> pointLights;
+
+	private:
+		struct HierarchyNode
+		{
+			Entity entity;
+			Entity parent;
+			// position of the parent in the flat array, NONE for roots
+			uint32_t parentIndex;
+			// this node plus all of its descendants
+			uint32_t subtreeSize;
+			// transform version the world matrix was last built from
+			uint32_t seenVersion;
+			// forces an update, e.g. after being reparented
+			bool stale;
+		};
+		static constexpr uint32_t NONE = ~0u;
+
+		uint32_t hierarchyIndex(Entity entity) const
+		{
+			assert(isValid(entity) && entity.index < nodeIndices.size() && nodeIndices[entity.index] != NONE);
+			return nodeIndices[entity.index];
+		}
+		// moves nodes [begin, begin + count) to start at 'to' (an index from before the move), along with their
+		// world matrices
+		void moveNodes(uint32_t begin, uint32_t count, uint32_t to);
+		void updateSubtreeSizes(uint32_t index, int delta);
+		void rebuildNodeIndices();
+		void retire(Entity entity);
+
+		// current generation of every slot, and slots free for reuse
+		std::vector<uint32_t> generations;
+		std::vector<uint32_t> freeSlots;
+
+		// depth-first hierarchy, with world matrices in the same order. nodeIndices maps slot -> position
+		std::vector<HierarchyNode> hierarchy;
+		std::vector<glm::mat4> worldMatrices;
+		std::vector<glm::mat3> worldNormalMatrices;
+		std::vector<uint32_t> nodeIndices;
+		// scratch for updateWorldMatrices, whether each node's world matrix changed this pass
+		std::vector<uint8_t> changed;
+		std::vector<Entity> movedEntities;
+		uint64_t renderablesVersion = 0;
+
+		std::unordered_map<std::string, Entity> names;
+	};
+} // namespace lve
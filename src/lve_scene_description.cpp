@@ -0,0 +1,484 @@
+#include "lve_scene_description.hpp"
+
+// std
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace lve
+{
+	namespace
+	{
+		constexpr char MAGIC[4] = { 'G', 'S', 'C', 'N' };
+		// 3: goal sizes are stored in x, y, z axis order
+		constexpr uint16_t VERSION = 3;
+
+		// ==============================
+		//   text form
+		// ==============================
+
+		class LineParser
+		{
+		public:
+			LineParser(const std::string& filename, int lineNumber) : filename{ filename }, lineNumber{ lineNumber } {}
+
+			[[noreturn]] void fail(const std::string& message) const
+			{
+				throw std::runtime_error(filename + ":" + std::to_string(lineNumber) + ": " + message);
+			}
+
+			float readFloat(const std::string& text) const
+			{
+				try
+				{
+					size_t used = 0;
+					float value = std::stof(text, &used);
+					if (used == text.size()) return value;
+				}
+				catch (const std::exception&)
+				{
+				}
+				fail("expected a number, got '" + text + "'");
+			}
+
+			int readInt(const std::string& text) const
+			{
+				try
+				{
+					size_t used = 0;
+					int value = std::stoi(text, &used);
+					if (used == text.size()) return value;
+				}
+				catch (const std::exception&)
+				{
+				}
+				fail("expected a whole number, got '" + text + "'");
+			}
+
+			// "x,y,z", or a single number for all three when allowSplat is set
+			glm::vec3 readVec3(const std::string& text, bool allowSplat = false) const
+			{
+				std::vector<std::string> parts{};
+				std::istringstream stream{ text };
+				std::string part;
+				while (std::getline(stream, part, ','))
+				{
+					parts.push_back(part);
+				}
+
+				if (parts.size() == 1 && allowSplat)
+				{
+					return glm::vec3{ readFloat(parts[0]) };
+				}
+				if (parts.size() != 3)
+				{
+					fail("expected x,y,z, got '" + text + "'");
+				}
+				return { readFloat(parts[0]), readFloat(parts[1]), readFloat(parts[2]) };
+			}
+
+			template <typename T>
+			int findByName(const std::vector<T>& items, const std::string& name, const char* kind) const
+			{
+				for (size_t i = 0; i < items.size(); i++)
+				{
+					if (items[i].name == name) return static_cast<int>(i);
+				}
+				fail(std::string("unknown ") + kind + " '" + name + "' (it has to be declared before it's used)");
+			}
+
+		private:
+			const std::string& filename;
+			int lineNumber;
+		};
+
+		// splits "key=value" (value is empty for plain flags like "outline")
+		void splitOption(const std::string& token, std::string& key, std::string& value)
+		{
+			size_t equals = token.find('=');
+			key = token.substr(0, equals);
+			value = equals == std::string::npos ? "" : token.substr(equals + 1);
+		}
+
+		// ==============================
+		//   compiled form
+		// ==============================
+
+		template <typename T>
+		void write(std::ofstream& file, const T& value)
+		{
+			char bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			file.write(bytes, sizeof(T));
+		}
+
+		void write(std::ofstream& file, const std::string& value)
+		{
+			write(file, static_cast<uint32_t>(value.size()));
+			file.write(value.data(), value.size());
+		}
+
+		void write(std::ofstream& file, const glm::vec3& value)
+		{
+			write(file, value.x);
+			write(file, value.y);
+			write(file, value.z);
+		}
+
+		template <typename T>
+		T read(std::istream& file, const std::string& filename)
+		{
+			char bytes[sizeof(T)];
+			if (!file.read(bytes, sizeof(T)))
+			{
+				throw std::runtime_error("compiled scene is truncated: " + filename);
+			}
+			T value;
+			std::memcpy(&value, bytes, sizeof(T));
+			return value;
+		}
+
+		std::string readString(std::istream& file, const std::string& filename)
+		{
+			std::string value(read<uint32_t>(file, filename), '\0');
+			if (!file.read(&value[0], value.size()))
+			{
+				throw std::runtime_error("compiled scene is truncated: " + filename);
+			}
+			return value;
+		}
+
+		glm::vec3 readVec3(std::istream& file, const std::string& filename)
+		{
+			glm::vec3 value;
+			value.x = read<float>(file, filename);
+			value.y = read<float>(file, filename);
+			value.z = read<float>(file, filename);
+			return value;
+		}
+
+		// everything the loader and the hole streamer index arrays with, checked the same way for both forms
+		void validate(const SceneDescription& description, const std::string& filename)
+		{
+			auto inRange = [](int index, size_t size) { return index >= -1 && index < static_cast<int>(size); };
+			for (size_t i = 0; i < description.objects.size(); i++)
+			{
+				const SceneDescription::Object& object = description.objects[i];
+				std::string prefix = filename + ": object " + (object.name.empty() ? std::to_string(i) : "'" + object.name + "'") + " ";
+				if (!inRange(object.parent, i))
+				{
+					throw std::runtime_error(prefix + "has a parent that isn't declared before it");
+				}
+				if (!inRange(object.model, description.models.size()))
+				{
+					throw std::runtime_error(prefix + "uses a model that isn't declared");
+				}
+				if (!inRange(object.material, description.materials.size()))
+				{
+					throw std::runtime_error(prefix + "uses a material that isn't declared");
+				}
+				if (!inRange(object.hole, description.holes.size()))
+				{
+					throw std::runtime_error(prefix + "is in hole " + std::to_string(object.hole) + ", which isn't declared");
+				}
+				if (object.parent >= 0)
+				{
+					int parentHole = description.objects[object.parent].hole;
+					if (parentHole != -1 && parentHole != object.hole)
+					{
+						throw std::runtime_error(prefix + "has a parent in another hole (it has to be in the same hole or in none)");
+					}
+				}
+			}
+			for (size_t i = 0; i < description.holes.size(); i++)
+			{
+				if (description.holes[i].colliderFile.empty())
+				{
+					throw std::runtime_error(filename + ": hole " + std::to_string(i) + " has no collider file");
+				}
+			}
+		}
+
+		SceneDescription readCompiled(std::istream& file, const std::string& filename)
+		{
+			if (read<uint16_t>(file, filename) != VERSION)
+			{
+				throw std::runtime_error("unsupported compiled scene version: " + filename);
+			}
+
+			SceneDescription description{};
+			description.models.resize(read<uint32_t>(file, filename));
+			for (SceneDescription::Model& model : description.models)
+			{
+				model.name = readString(file, filename);
+				model.path = readString(file, filename);
+			}
+
+			description.materials.resize(read<uint32_t>(file, filename));
+			for (SceneDescription::Material& material : description.materials)
+			{
+				material.name = readString(file, filename);
+				material.id = read<int32_t>(file, filename);
+				material.specular = read<float>(file, filename);
+				material.alpha = read<float>(file, filename);
+			}
+
+			description.objects.resize(read<uint32_t>(file, filename));
+			for (SceneDescription::Object& object : description.objects)
+			{
+				object.name = readString(file, filename);
+				object.parent = read<int32_t>(file, filename);
+				object.model = read<int32_t>(file, filename);
+				object.material = read<int32_t>(file, filename);
+				object.hole = read<int32_t>(file, filename);
+				object.position = readVec3(file, filename);
+				object.rotation = readVec3(file, filename);
+				object.scale = readVec3(file, filename);
+				uint8_t flags = read<uint8_t>(file, filename);
+				object.outline = (flags & 1) != 0;
+				object.visible = (flags & 2) != 0;
+			}
+
+			description.lights.resize(read<uint32_t>(file, filename));
+			for (SceneDescription::Light& light : description.lights)
+			{
+				light.position = readVec3(file, filename);
+				light.color = readVec3(file, filename);
+				light.intensity = read<float>(file, filename);
+				light.radius = read<float>(file, filename);
+			}
+
+			description.holes.resize(read<uint32_t>(file, filename));
+			for (SceneDescription::Hole& hole : description.holes)
+			{
+				hole.tee = readVec3(file, filename);
+				hole.colliderFile = readString(file, filename);
+				hole.goal = readVec3(file, filename);
+				hole.goalSize = readVec3(file, filename);
+			}
+			validate(description, filename);
+			return description;
+		}
+	}
+
+	SceneDescription SceneDescription::load(const std::string& filename)
+	{
+		std::string path = ENGINE_DIR + filename;
+		std::ifstream file{ path, std::ios::binary };
+		if (!file.is_open())
+		{
+			throw std::runtime_error("failed to open file: " + path);
+		}
+
+		// compiled scenes start with the magic, anything else is treated as text
+		char magic[sizeof(MAGIC)];
+		if (file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0)
+		{
+			return readCompiled(file, path);
+		}
+		file.clear();
+		file.seekg(0);
+		return parse(file, path);
+	}
+
+	SceneDescription SceneDescription::parse(std::istream& stream, const std::string& filename)
+	{
+		SceneDescription description{};
+		std::vector<bool> holeDeclared{};
+
+		std::string line;
+		int lineNumber = 0;
+		while (std::getline(stream, line))
+		{
+			lineNumber++;
+			LineParser parser{ filename, lineNumber };
+
+			size_t comment = line.find('#');
+			if (comment != std::string::npos)
+			{
+				line.erase(comment);
+			}
+
+			std::istringstream words{ line };
+			std::vector<std::string> tokens{};
+			std::string token;
+			while (words >> token)
+			{
+				tokens.push_back(token);
+			}
+			if (tokens.empty()) continue;
+
+			const std::string& kind = tokens[0];
+			std::string key, value;
+			if (kind == "model")
+			{
+				if (tokens.size() != 3) parser.fail("expected: model <name> <obj file>");
+				description.models.push_back(Model{ tokens[1], tokens[2] });
+			}
+			else if (kind == "material")
+			{
+				if (tokens.size() < 2) parser.fail("expected: material <name> ...");
+				Material material{};
+				material.name = tokens[1];
+				for (size_t i = 2; i < tokens.size(); i++)
+				{
+					splitOption(tokens[i], key, value);
+					if (key == "id") material.id = parser.readInt(value);
+					else if (key == "specular") material.specular = parser.readFloat(value);
+					else if (key == "alpha") material.alpha = parser.readFloat(value);
+					else parser.fail("unknown material option '" + key + "'");
+				}
+				description.materials.push_back(material);
+			}
+			else if (kind == "object")
+			{
+				Object object{};
+				for (size_t i = 1; i < tokens.size(); i++)
+				{
+					splitOption(tokens[i], key, value);
+					if (key == "name") object.name = value;
+					else if (key == "parent") object.parent = parser.findByName(description.objects, value, "object");
+					else if (key == "model") object.model = parser.findByName(description.models, value, "model");
+					else if (key == "material") object.material = parser.findByName(description.materials, value, "material");
+					else if (key == "hole") object.hole = parser.readInt(value);
+					else if (key == "position") object.position = parser.readVec3(value);
+					else if (key == "rotation") object.rotation = parser.readVec3(value);
+					else if (key == "scale") object.scale = parser.readVec3(value, true);
+					else if (key == "outline") object.outline = true;
+					else if (key == "hidden") object.visible = false;
+					else parser.fail("unknown object option '" + key + "'");
+				}
+				description.objects.push_back(object);
+			}
+			else if (kind == "light")
+			{
+				Light light{};
+				for (size_t i = 1; i < tokens.size(); i++)
+				{
+					splitOption(tokens[i], key, value);
+					if (key == "position") light.position = parser.readVec3(value);
+					else if (key == "color") light.color = parser.readVec3(value);
+					else if (key == "intensity") light.intensity = parser.readFloat(value);
+					else if (key == "radius") light.radius = parser.readFloat(value);
+					else parser.fail("unknown light option '" + key + "'");
+				}
+				description.lights.push_back(light);
+			}
+			else if (kind == "hole")
+			{
+				if (tokens.size() < 2) parser.fail("expected: hole <index> ...");
+				int index = parser.readInt(tokens[1]);
+				if (index < 0) parser.fail("hole index can't be negative");
+				if (index >= static_cast<int>(description.holes.size()))
+				{
+					description.holes.resize(index + 1);
+					holeDeclared.resize(index + 1, false);
+				}
+				if (holeDeclared[index]) parser.fail("hole " + tokens[1] + " is declared twice");
+				holeDeclared[index] = true;
+
+				Hole& hole = description.holes[index];
+				bool hasTee = false, hasGoal = false;
+				for (size_t i = 2; i < tokens.size(); i++)
+				{
+					splitOption(tokens[i], key, value);
+					if (key == "tee") { hole.tee = parser.readVec3(value); hasTee = true; }
+					else if (key == "colliders") hole.colliderFile = value;
+					else if (key == "goal") { hole.goal = parser.readVec3(value); hasGoal = true; }
+					else if (key == "goalsize") hole.goalSize = parser.readVec3(value);
+					else parser.fail("unknown hole option '" + key + "'");
+				}
+				if (!hasTee || !hasGoal || hole.colliderFile.empty())
+				{
+					parser.fail("every hole needs a tee, a goal and a collider file");
+				}
+			}
+			else
+			{
+				parser.fail("unknown entry '" + kind + "'");
+			}
+		}
+
+		for (size_t i = 0; i < holeDeclared.size(); i++)
+		{
+			if (!holeDeclared[i])
+			{
+				throw std::runtime_error(filename + ": hole " + std::to_string(i) + " is missing");
+			}
+		}
+		validate(description, filename);
+		return description;
+	}
+
+	void SceneDescription::save(const std::string& filename) const
+	{
+		std::string path = ENGINE_DIR + filename;
+		std::ofstream file{ path, std::ios::binary };
+		if (!file.is_open())
+		{
+			throw std::runtime_error("failed to open file: " + path);
+		}
+
+		file.write(MAGIC, sizeof(MAGIC));
+		write(file, VERSION);
+
+		write(file, static_cast<uint32_t>(models.size()));
+		for (const Model& model : models)
+		{
+			write(file, model.name);
+			write(file, model.path);
+		}
+
+		write(file, static_cast<uint32_t>(materials.size()));
+		for (const Material& material : materials)
+		{
+			write(file, material.name);
+			write(file, static_cast<int32_t>(material.id));
+			write(file, material.specular);
+			write(file, material.alpha);
+		}
+
+		write(file, static_cast<uint32_t>(objects.size()));
+		for (const Object& object : objects)
+		{
+			write(file, object.name);
+			write(file, static_cast<int32_t>(object.parent));
+			write(file, static_cast<int32_t>(object.model));
+			write(file, static_cast<int32_t>(object.material));
+			write(file, static_cast<int32_t>(object.hole));
+			write(file, object.position);
+			write(file, object.rotation);
+			write(file, object.scale);
+			write(file, static_cast<uint8_t>((object.outline ? 1 : 0) | (object.visible ? 2 : 0)));
+		}
+
+		write(file, static_cast<uint32_t>(lights.size()));
+		for (const Light& light : lights)
+		{
+			write(file, light.position);
+			write(file, light.color);
+			write(file, light.intensity);
+			write(file, light.radius);
+		}
+
+		write(file, static_cast<uint32_t>(holes.size()));
+		for (const Hole& hole : holes)
+		{
+			write(file, hole.tee);
+			write(file, hole.colliderFile);
+			write(file, hole.goal);
+			write(file, hole.goalSize);
+		}
+
+		if (!file)
+		{
+			throw std::runtime_error("failed to write compiled scene: " + path);
+		}
+	}
+} // namespace lve
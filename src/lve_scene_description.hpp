@@ -0,0 +1,91 @@
+#pragma once
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace lve
+{
+	// Everything a course needs to be built: the models, materials, objects and lights that make up the scene,
+	// and the tee, goal and collider file of every hole. Plain data, so the headless simulator can read the
+	// same files as the game.
+	//
+	// Written by hand as a text .scene file, one entry per line ('#' starts a comment):
+	//   model <name> <obj file>
+	//   material <name> [id=<render material>] [specular=<s>] [alpha=<a>]
+	//   object [name=<name>] [parent=<object>] [model=<model>] [material=<material>] [hole=<index>]
+	//          [position=x,y,z] [rotation=x,y,z] [scale=x,y,z or s] [outline] [hidden]
+	//   light position=x,y,z [color=r,g,b] [intensity=<i>] [radius=<r>]
+	//   hole <index> tee=x,y,z colliders=<boxc file> goal=x,y,z [goalsize=w,h,d]
+	// Names have to be declared before anything refers to them, which also keeps parents ahead of their children.
+	// Objects tagged with a hole can be streamed in and out with it. Untagged objects are always loaded, and a
+	// tagged object's parent has to be untagged or in the same hole.
+	// save() writes the same thing in a compiled binary form, and load() reads either
+	struct SceneDescription
+	{
+		struct Model
+		{
+			std::string name;
+			std::string path;
+		};
+
+		struct Material
+		{
+			std::string name;
+			int id = 0;
+			float specular = 0.0f;
+			float alpha = 1.0f;
+		};
+
+		// model, material and parent are indices into their arrays, -1 for none.
+		// hole is the hole the object belongs to, -1 for the whole course
+		struct Object
+		{
+			std::string name;
+			int parent = -1;
+			int model = -1;
+			int material = -1;
+			int hole = -1;
+			glm::vec3 position{ 0.0f };
+			glm::vec3 rotation{ 0.0f };
+			glm::vec3 scale{ 1.0f };
+			bool outline = false;
+			bool visible = true;
+		};
+
+		struct Light
+		{
+			glm::vec3 position{ 0.0f };
+			glm::vec3 color{ 1.0f };
+			float intensity = 10.0f;
+			float radius = 0.3f;
+		};
+
+		struct Hole
+		{
+			glm::vec3 tee{ 0.0f };
+			std::string colliderFile;
+			// goal trigger box centre, and half its size along each axis
+			glm::vec3 goal{ 0.0f };
+			glm::vec3 goalSize{ 0.15f, 0.25f, 0.15f };
+		};
+
+		std::vector<Model> models;
+		std::vector<Material> materials;
+		std::vector<Object> objects;
+		std::vector<Light> lights;
+		// indexed by hole number
+		std::vector<Hole> holes;
+
+		// reads a text or compiled scene, relative to the engine directory
+		static SceneDescription load(const std::string& filename);
+		// reads the text form. The filename is only used in error messages
+		static SceneDescription parse(std::istream& stream, const std::string& filename);
+		// writes the compiled form, relative to the engine directory
+		void save(const std::string& filename) const;
+	};
+} // namespace lve
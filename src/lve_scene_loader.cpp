@@ -0,0 +1,142 @@
+#include "lve_scene_loader.hpp"
+
+#include "collision/collision_manager.hpp"
+
+// std
+#include <stdexcept>
+
+#ifndef ENGINE_DIR
+#define ENGINE_DIR "../"
+#endif
+
+namespace lve
+{
+	LveSceneLoader::LveSceneLoader(LveDevice& device, LveAssetCache& assets, LveThreadPool& threadPool)
+		: device{ device }, assets{ assets }, threadPool{ threadPool } {}
+
+	LveSceneLoader::~LveSceneLoader()
+	{
+		if (!loading.valid()) return;
+		try
+		{
+			Loading result = threadPool.wait(loading);
+			// nothing is going to call getModel for what it prefetched now
+			for (const std::string& path : result.modelPaths)
+			{
+				if (!path.empty()) assets.cancelPrefetch(path);
+			}
+		}
+		catch (...)
+		{
+			// finish would have reported it, but it's too late for that
+		}
+	}
+
+	LveGameObject LveSceneLoader::makeGameObject(const SceneDescription& description, const SceneDescription::Object& object,
+		std::shared_ptr<LveModel> model)
+	{
+		auto gameObject = LveGameObject::createGameObject();
+		gameObject.model = std::move(model);
+		gameObject.transform.setTranslation(object.position);
+		gameObject.transform.setRotation(object.rotation);
+		gameObject.transform.setScale(object.scale);
+		gameObject.outline = object.outline;
+		gameObject.isVisible = object.visible;
+		if (object.material >= 0)
+		{
+			const SceneDescription::Material& material = description.materials[object.material];
+			gameObject.materialId = material.id;
+			gameObject.specular = material.specular;
+			gameObject.alpha = material.alpha;
+		}
+		return gameObject;
+	}
+
+	void LveSceneLoader::start(const std::string& filename, bool streamHoles)
+	{
+		loading = threadPool.submit([this, filename, streamHoles]() { return parseScene(filename, streamHoles); });
+	}
+
+	LveSceneLoader::Loading LveSceneLoader::parseScene(const std::string& filename, bool streamHoles)
+	{
+		Loading result{};
+		result.description = SceneDescription::load(filename);
+		result.streamHoles = streamHoles;
+
+		std::vector<bool> used(result.description.models.size(), false);
+		for (const SceneDescription::Object& object : result.description.objects)
+		{
+			if (object.model >= 0 && (!streamHoles || object.hole < 0)) used[object.model] = true;
+		}
+
+		result.modelPaths.resize(result.description.models.size());
+		for (size_t i = 0; i < result.description.models.size(); i++)
+		{
+			if (!used[i]) continue;
+			result.modelPaths[i] = ENGINE_DIR + result.description.models[i].path;
+			assets.prefetch(result.modelPaths[i]);
+		}
+
+		// every hole's colliders, even when its meshes are streamed, so the ball always hits the same course
+		for (const SceneDescription::Hole& hole : result.description.holes)
+		{
+			std::string path = hole.colliderFile;
+			result.colliders.push_back(threadPool.submit([path]() {
+				return CollisionManager::readCollidersFromFile(path);
+			}));
+		}
+		return result;
+	}
+
+	void LveSceneLoader::finish(LveScene& scene, CourseWorld& world)
+	{
+		if (!loading.valid())
+		{
+			throw std::runtime_error("LveSceneLoader::finish called without start");
+		}
+		Loading result = threadPool.wait(loading);
+		description = std::move(result.description);
+
+		// in declaration order, so the first few are usually done by the time we get here
+		LveUploadBatch uploads{ device };
+		std::vector<std::shared_ptr<LveModel>> models(description.models.size());
+		for (size_t i = 0; i < result.modelPaths.size(); i++)
+		{
+			if (result.modelPaths[i].empty()) continue;
+			models[i] = assets.getModel(result.modelPaths[i], &uploads);
+		}
+		uploads.submit();
+
+		std::vector<std::vector<BoxCollider>> holeColliders{};
+		for (auto& colliders : result.colliders)
+		{
+			holeColliders.push_back(threadPool.wait(colliders));
+		}
+		world.loadCourse(description, holeColliders);
+
+		// parents always come before their children in the description
+		entities.clear();
+		for (const SceneDescription::Object& object : description.objects)
+		{
+			if (result.streamHoles && object.hole >= 0)
+			{
+				entities.emplace_back();
+				continue;
+			}
+
+			std::shared_ptr<LveModel> model = object.model >= 0 ? models[object.model] : nullptr;
+			auto gameObject = makeGameObject(description, object, std::move(model));
+			LveScene::Entity parent = object.parent >= 0 ? entities[object.parent] : LveScene::Entity{};
+			entities.push_back(scene.add(std::move(gameObject), object.name, parent));
+		}
+
+		for (const SceneDescription::Light& light : description.lights)
+		{
+			auto pointLight = LveGameObject::makePointLight(light.intensity, light.radius, light.color);
+			pointLight.transform.setTranslation(light.position);
+			scene.add(std::move(pointLight));
+		}
+
+		uploads.wait();
+	}
+} // namespace lve
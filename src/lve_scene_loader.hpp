@@ -0,0 +1,72 @@
+#pragma once
+
+#include "lve_asset_cache.hpp"
+#include "lve_device.hpp"
+#include "lve_model.hpp"
+#include "lve_scene.hpp"
+#include "lve_scene_description.hpp"
+#include "lve_thread_pool.hpp"
+#include "collision/box_collider.hpp"
+#include "physics/course_world.hpp"
+
+// std
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace lve
+{
+	// Builds a scene and course from a scene file without loading everything one file at a time.
+	// start() hands the scene file to the thread pool, which parses it and then prefetches every model through
+	// the asset cache and fans out one job per collider file. finish() waits on those, staging each model for
+	// upload as soon as it's parsed (models something else already holds are just shared), and sends
+	// every model to the GPU in one submit (LveUploadBatch) that runs while the scene is filled in.
+	// Anything can run between the two, so the loading overlaps with whatever else startup is doing.
+	// With streamHoles set, only the objects that aren't tagged with a hole are loaded, and LveHoleStreamer takes
+	// care of the rest. The course world gets every hole's colliders either way
+	class LveSceneLoader
+	{
+	public:
+		LveSceneLoader(LveDevice& device, LveAssetCache& assets, LveThreadPool& threadPool = LveThreadPool::global());
+		// waits for a load that was started but never finished, since it runs on this
+		~LveSceneLoader();
+
+		LveSceneLoader(const LveSceneLoader&) = delete;
+		LveSceneLoader& operator=(const LveSceneLoader&) = delete;
+
+		void start(const std::string& filename, bool streamHoles = false);
+		// rethrows anything that went wrong while loading. Named objects keep their names in the scene
+		void finish(LveScene& scene, CourseWorld& world);
+
+		// the game object for one entry of a description, minus any parent
+		static LveGameObject makeGameObject(const SceneDescription& description, const SceneDescription::Object& object,
+			std::shared_ptr<LveModel> model);
+
+		// valid after finish
+		const SceneDescription& getDescription() const { return description; }
+		// the entity made for each object in the description, null for ones left to streaming
+		const std::vector<LveScene::Entity>& getEntities() const { return entities; }
+
+	private:
+		struct Loading
+		{
+			SceneDescription description;
+			bool streamHoles = false;
+			// one per model in the description, already prefetched. Empty for models nothing uses
+			std::vector<std::string> modelPaths;
+			// one per hole
+			std::vector<std::future<std::vector<BoxCollider>>> colliders;
+		};
+
+		Loading parseScene(const std::string& filename, bool streamHoles);
+
+		LveDevice& device;
+		LveAssetCache& assets;
+		LveThreadPool& threadPool;
+		std::future<Loading> loading;
+
+		SceneDescription description;
+		std::vector<LveScene::Entity> entities;
+	};
+} // namespace lve
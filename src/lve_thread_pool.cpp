@@ -0,0 +1,106 @@
+#include "lve_thread_pool.hpp"
+
+// std
+#include <algorithm>
+#include <exception>
+
+namespace lve {
+
+	LveThreadPool::LveThreadPool(unsigned int threadCount) {
+		if (threadCount == 0) {
+			unsigned int hardwareThreads = std::thread::hardware_concurrency();
+			threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		for (unsigned int i = 0; i < threadCount; i++) {
+			workers.emplace_back([this]() { workerLoop(); });
+		}
+	}
+
+	LveThreadPool::~LveThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock{ queueMutex };
+			stopping = true;
+		}
+		queueCondition.notify_all();
+		for (std::thread& worker : workers) {
+			worker.join();
+		}
+	}
+
+	LveThreadPool& LveThreadPool::global() {
+		static LveThreadPool pool{};
+		return pool;
+	}
+
+	void LveThreadPool::workerLoop() {
+		while (true) {
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock{ queueMutex };
+				queueCondition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+				if (stopping && tasks.empty()) {
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop();
+			}
+			task();
+		}
+	}
+
+	bool LveThreadPool::runPendingTask() {
+		std::function<void()> task;
+		{
+			std::lock_guard<std::mutex> lock{ queueMutex };
+			if (tasks.empty()) {
+				return false;
+			}
+			task = std::move(tasks.front());
+			tasks.pop();
+		}
+		task();
+		return true;
+	}
+
+	void LveThreadPool::parallelFor(size_t count, size_t minRange, const std::function<void(size_t, size_t)>& task) {
+		if (count == 0) {
+			return;
+		}
+
+		size_t rangeCount = std::min<size_t>(getConcurrency(), (count + minRange - 1) / std::max<size_t>(minRange, 1));
+		rangeCount = std::max<size_t>(rangeCount, 1);
+		size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+
+		// the submitted ranges hold references to task (and usually to the caller's stack), so every one of them
+		// has to finish before an exception can leave here. The first one thrown is rethrown after that
+		std::vector<std::future<void>> results;
+		std::exception_ptr error{};
+		try {
+			results.reserve(rangeCount - 1);
+			for (size_t begin = rangeSize; begin < count; begin += rangeSize) {
+				size_t end = std::min(begin + rangeSize, count);
+				results.push_back(submit([&task, begin, end]() { task(begin, end); }));
+			}
+
+			// the calling thread takes the first range itself
+			task(0, std::min(rangeSize, count));
+		} catch (...) {
+			error = std::current_exception();
+		}
+
+		for (std::future<void>& result : results) {
+			try {
+				wait(result);
+			} catch (...) {
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+}  // namespace lve
@@ -0,0 +1,85 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace lve {
+
+	// Fixed set of worker threads fed from a single task queue.
+	// Threads that wait on a result from the pool help run queued tasks in the meantime,
+	// so tasks can safely wait on other tasks without deadlocking the pool
+	class LveThreadPool {
+	public:
+		// 0 picks one worker per hardware thread, minus the calling thread
+		explicit LveThreadPool(unsigned int threadCount = 0);
+		~LveThreadPool();
+
+		LveThreadPool(const LveThreadPool&) = delete;
+		LveThreadPool& operator=(const LveThreadPool&) = delete;
+
+		template <typename F>
+		auto submit(F&& task) -> std::future<decltype(task())> {
+			using R = decltype(task());
+			auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+			std::future<R> result = packaged->get_future();
+			{
+				std::lock_guard<std::mutex> lock{ queueMutex };
+				tasks.emplace([packaged]() { (*packaged)(); });
+			}
+			queueCondition.notify_one();
+			return result;
+		}
+
+		// waits for the future, running queued tasks on this thread until it is ready
+		template <typename R>
+		R wait(std::future<R>& result) {
+			while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				if (!runPendingTask()) {
+					result.wait();
+				}
+			}
+			return result.get();
+		}
+
+		template <typename R>
+		const R& wait(const std::shared_future<R>& result) {
+			while (result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+				if (!runPendingTask()) {
+					result.wait();
+				}
+			}
+			return result.get();
+		}
+
+		// splits [0, count) into contiguous ranges of at least minRange items, runs task(begin, end) on
+		// the workers and the calling thread, and returns once every range is done. If any range throws, the
+		// first exception is rethrown once the rest have finished
+		void parallelFor(size_t count, size_t minRange, const std::function<void(size_t, size_t)>& task);
+
+		// number of threads that can work at once, including the calling thread
+		unsigned int getConcurrency() const { return static_cast<unsigned int>(workers.size()) + 1; }
+
+		// shared pool for code that doesn't own one
+		static LveThreadPool& global();
+
+	private:
+		void workerLoop();
+		bool runPendingTask();
+
+		std::vector<std::thread> workers;
+		std::queue<std::function<void()>> tasks;
+		std::mutex queueMutex;
+		std::condition_variable queueCondition;
+		bool stopping = false;
+	};
+
+}  // namespace lve
@@ -0,0 +1,227 @@
+#include "lve_transform_batch.hpp"
+
+// std
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LVE_TRANSFORM_SSE2
+#endif
+
+namespace lve
+{
+	namespace
+	{
+		// rotation part of Ry * Rx * Rz, column major, shared by the model and normal matrix
+		struct Rotation
+		{
+			float m[3][3];
+		};
+
+		Rotation rotationMatrix(float x, float y, float z)
+		{
+			const float c3 = std::cos(z);
+			const float s3 = std::sin(z);
+			const float c2 = std::cos(x);
+			const float s2 = std::sin(x);
+			const float c1 = std::cos(y);
+			const float s1 = std::sin(y);
+			return Rotation{ {
+				{ c1 * c3 + s1 * s2 * s3, c2 * s3, c1 * s2 * s3 - c3 * s1 },
+				{ c3 * s1 * s2 - c1 * s3, c2 * c3, c1 * c3 * s2 + s1 * s3 },
+				{ c2 * s1, -s2, c1 * c2 },
+			} };
+		}
+
+#ifdef LVE_TRANSFORM_SSE2
+		// sin and cos of 4 angles at once. Cephes style: reduce to [-pi/4, pi/4] around the nearest multiple
+		// of pi/4, evaluate both minimax polynomials, then swap and flip signs depending on the octant.
+		// Good to ~1e-7 for the angle range a transform will ever see
+		void sincos4(__m128 x, __m128& sinOut, __m128& cosOut)
+		{
+			const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+
+			__m128 sinSign = _mm_and_ps(x, signMask);
+			x = _mm_andnot_ps(signMask, x);
+
+			// octant, rounded up to even so the remainder is centred on zero
+			__m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+			octant = _mm_add_epi32(octant, _mm_set1_epi32(1));
+			octant = _mm_and_si128(octant, _mm_set1_epi32(~1));
+			__m128 y = _mm_cvtepi32_ps(octant);
+
+			__m128 swapSinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+			__m128 cosSign = _mm_castsi128_ps(
+				_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+			__m128 usePolySin = _mm_castsi128_ps(
+				_mm_cmpeq_epi32(_mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+			sinSign = _mm_xor_ps(sinSign, swapSinSign);
+
+			// x - y * pi/4, in three parts so the subtraction stays exact
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+			x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+			__m128 z = _mm_mul_ps(x, x);
+
+			__m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+			cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765e-3f));
+			cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827e-2f));
+			cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+			cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+			cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+			__m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+			sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736e-3f));
+			sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611e-1f));
+			sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+			__m128 sinResult = _mm_or_ps(_mm_and_ps(usePolySin, sinPoly), _mm_andnot_ps(usePolySin, cosPoly));
+			__m128 cosResult = _mm_or_ps(_mm_and_ps(usePolySin, cosPoly), _mm_andnot_ps(usePolySin, sinPoly));
+			sinOut = _mm_xor_ps(sinResult, sinSign);
+			cosOut = _mm_xor_ps(cosResult, cosSign);
+		}
+
+		// turns one column of 4 matrices (one register per row) into 4 columns and stores them
+		void storeColumn(glm::mat4* matrices, int column, __m128 x, __m128 y, __m128 z, __m128 w)
+		{
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(&matrices[0][column][0], x);
+			_mm_storeu_ps(&matrices[1][column][0], y);
+			_mm_storeu_ps(&matrices[2][column][0], z);
+			_mm_storeu_ps(&matrices[3][column][0], w);
+		}
+#endif
+	}
+
+	LveTransformBatch::LveTransformBatch(LveThreadPool& threadPool) : threadPool{ threadPool } {}
+
+	size_t LveTransformBatch::add(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		size_t index = size();
+		resize(index + 1);
+		set(index, translation, rotation, scale);
+		return index;
+	}
+
+	void LveTransformBatch::resize(size_t count)
+	{
+		translationX.resize(count, 0.0f);
+		translationY.resize(count, 0.0f);
+		translationZ.resize(count, 0.0f);
+		rotationX.resize(count, 0.0f);
+		rotationY.resize(count, 0.0f);
+		rotationZ.resize(count, 0.0f);
+		scaleX.resize(count, 1.0f);
+		scaleY.resize(count, 1.0f);
+		scaleZ.resize(count, 1.0f);
+		modelMatrices.resize(count, glm::mat4{ 1.0f });
+		normalMatrices.resize(count, glm::mat4{ 1.0f });
+	}
+
+	void LveTransformBatch::clear()
+	{
+		resize(0);
+	}
+
+	void LveTransformBatch::set(size_t index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
+	{
+		translationX[index] = translation.x;
+		translationY[index] = translation.y;
+		translationZ[index] = translation.z;
+		rotationX[index] = rotation.x;
+		rotationY[index] = rotation.y;
+		rotationZ[index] = rotation.z;
+		scaleX[index] = scale.x;
+		scaleY[index] = scale.y;
+		scaleZ[index] = scale.z;
+	}
+
+	void LveTransformBatch::gather(LveComponentPool<TransformComponent>& transforms)
+	{
+		resize(transforms.size());
+		for (size_t i = 0; i < transforms.size(); i++)
+		{
+			const TransformComponent& transform = transforms.data()[i];
+			set(i, transform.getTranslation(), transform.getRotation(), transform.getScale());
+		}
+	}
+
+	void LveTransformBatch::update()
+	{
+		threadPool.parallelFor(size(), minRange, [this](size_t begin, size_t end) { updateRange(begin, end); });
+	}
+
+	void LveTransformBatch::updateRange(size_t begin, size_t end)
+	{
+		size_t i = begin;
+
+#ifdef LVE_TRANSFORM_SSE2
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= end; i += 4)
+		{
+			__m128 s1, c1, s2, c2, s3, c3;
+			sincos4(_mm_loadu_ps(&rotationY[i]), s1, c1);
+			sincos4(_mm_loadu_ps(&rotationX[i]), s2, c2);
+			sincos4(_mm_loadu_ps(&rotationZ[i]), s3, c3);
+
+			__m128 s1s2 = _mm_mul_ps(s1, s2);
+			__m128 c1s2 = _mm_mul_ps(c1, s2);
+			__m128 r00 = _mm_add_ps(_mm_mul_ps(c1, c3), _mm_mul_ps(s1s2, s3));
+			__m128 r01 = _mm_mul_ps(c2, s3);
+			__m128 r02 = _mm_sub_ps(_mm_mul_ps(c1s2, s3), _mm_mul_ps(c3, s1));
+			__m128 r10 = _mm_sub_ps(_mm_mul_ps(s1s2, c3), _mm_mul_ps(c1, s3));
+			__m128 r11 = _mm_mul_ps(c2, c3);
+			__m128 r12 = _mm_add_ps(_mm_mul_ps(c1s2, c3), _mm_mul_ps(s1, s3));
+			__m128 r20 = _mm_mul_ps(c2, s1);
+			__m128 r21 = _mm_sub_ps(zero, s2);
+			__m128 r22 = _mm_mul_ps(c1, c2);
+
+			__m128 sx = _mm_loadu_ps(&scaleX[i]);
+			__m128 sy = _mm_loadu_ps(&scaleY[i]);
+			__m128 sz = _mm_loadu_ps(&scaleZ[i]);
+
+			glm::mat4* model = &modelMatrices[i];
+			storeColumn(model, 0, _mm_mul_ps(sx, r00), _mm_mul_ps(sx, r01), _mm_mul_ps(sx, r02), zero);
+			storeColumn(model, 1, _mm_mul_ps(sy, r10), _mm_mul_ps(sy, r11), _mm_mul_ps(sy, r12), zero);
+			storeColumn(model, 2, _mm_mul_ps(sz, r20), _mm_mul_ps(sz, r21), _mm_mul_ps(sz, r22), zero);
+			storeColumn(model, 3, _mm_loadu_ps(&translationX[i]), _mm_loadu_ps(&translationY[i]),
+				_mm_loadu_ps(&translationZ[i]), one);
+
+			// same rotation, inverse scale
+			__m128 ix = _mm_div_ps(one, sx);
+			__m128 iy = _mm_div_ps(one, sy);
+			__m128 iz = _mm_div_ps(one, sz);
+
+			glm::mat4* normal = &normalMatrices[i];
+			storeColumn(normal, 0, _mm_mul_ps(ix, r00), _mm_mul_ps(ix, r01), _mm_mul_ps(ix, r02), zero);
+			storeColumn(normal, 1, _mm_mul_ps(iy, r10), _mm_mul_ps(iy, r11), _mm_mul_ps(iy, r12), zero);
+			storeColumn(normal, 2, _mm_mul_ps(iz, r20), _mm_mul_ps(iz, r21), _mm_mul_ps(iz, r22), zero);
+			storeColumn(normal, 3, zero, zero, zero, one);
+		}
+#endif
+
+		// whatever doesn't fill a full group of 4 (or everything, without SSE2)
+		for (; i < end; i++)
+		{
+			Rotation r = rotationMatrix(rotationX[i], rotationY[i], rotationZ[i]);
+			glm::vec3 scale{ scaleX[i], scaleY[i], scaleZ[i] };
+			glm::vec3 invScale = 1.0f / scale;
+
+			glm::mat4& model = modelMatrices[i];
+			glm::mat4& normal = normalMatrices[i];
+			for (int column = 0; column < 3; column++)
+			{
+				for (int row = 0; row < 3; row++)
+				{
+					model[column][row] = scale[column] * r.m[column][row];
+					normal[column][row] = invScale[column] * r.m[column][row];
+				}
+				model[column][3] = 0.0f;
+				normal[column][3] = 0.0f;
+			}
+			model[3] = glm::vec4{ translationX[i], translationY[i], translationZ[i], 1.0f };
+			normal[3] = glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f };
+		}
+	}
+} // namespace lve
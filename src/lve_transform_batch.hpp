@@ -0,0 +1,59 @@
+#pragma once
+
+#include "lve_game_object.hpp"
+#include "lve_scene.hpp"
+#include "lve_thread_pool.hpp"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <cstddef>
+#include <vector>
+
+namespace lve
+{
+	// Computes model and normal matrices for lots of transforms at once, for when there are thousands of moving
+	// objects and TransformComponent::mat4() one at a time gets too slow.
+	// Inputs are structure-of-arrays so 4 transforms go through each SIMD instruction (sin/cos included), and the
+	// batch is split into contiguous ranges on the thread pool. The outputs are plain contiguous arrays of mat4,
+	// in the same layout the push constants / an instance buffer use, so they can be copied straight to the GPU.
+	// Same convention as TransformComponent: Translate * Ry * Rx * Rz * Scale
+	class LveTransformBatch
+	{
+	public:
+		explicit LveTransformBatch(LveThreadPool& threadPool = LveThreadPool::global());
+
+		// returns the index of the new transform
+		size_t add(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale = glm::vec3{ 1.0f });
+		void resize(size_t count);
+		void clear();
+
+		void set(size_t index, const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale);
+		// copies every transform out of the pool, in dense order
+		void gather(LveComponentPool<TransformComponent>& transforms);
+
+		// recomputes every matrix
+		void update();
+
+		size_t size() const { return translationX.size(); }
+		const glm::mat4* getModelMatrices() const { return modelMatrices.data(); }
+		// mat3 padded out to a mat4, like the push constants
+		const glm::mat4* getNormalMatrices() const { return normalMatrices.data(); }
+
+		// transforms per range handed to a worker
+		size_t minRange = 2048;
+
+		std::vector<float> translationX, translationY, translationZ;
+		std::vector<float> rotationX, rotationY, rotationZ;
+		std::vector<float> scaleX, scaleY, scaleZ;
+
+	private:
+		void updateRange(size_t begin, size_t end);
+
+		LveThreadPool& threadPool;
+
+		std::vector<glm::mat4> modelMatrices;
+		std::vector<glm::mat4> normalMatrices;
+	};
+} // namespace lve
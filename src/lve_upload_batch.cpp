@@ -0,0 +1,128 @@
+#include "lve_upload_batch.hpp"
+
+// std
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace lve
+{
+	namespace
+	{
+		// keeps every copy's source offset nicely aligned for the transfer
+		constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+	}
+
+	LveUploadBatch::LveUploadBatch(LveDevice& device) : lveDevice{ device } {}
+
+	LveUploadBatch::~LveUploadBatch()
+	{
+		// doesn't submit, since that can throw; copies that were never submitted are just dropped
+		release();
+	}
+
+	void LveUploadBatch::copyToBuffer(const void* data, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset)
+	{
+		if (size == 0) return;
+		if (commandBuffer != VK_NULL_HANDLE)
+		{
+			throw std::runtime_error("upload batch was added to after it was submitted");
+		}
+
+		VkDeviceSize offset = chunks.empty() ? 0 : (chunks.back().used + STAGING_ALIGNMENT - 1) / STAGING_ALIGNMENT * STAGING_ALIGNMENT;
+		if (chunks.empty() || offset + size > chunks.back().buffer->getBufferSize())
+		{
+			// anything bigger than a chunk gets a chunk of its own
+			auto buffer = std::make_unique<LveBuffer>(
+				lveDevice,
+				1,
+				static_cast<uint32_t>(std::max(size, STAGING_CHUNK_SIZE)),
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			buffer->map();
+			chunks.push_back(Chunk{ std::move(buffer), 0 });
+			offset = 0;
+		}
+
+		Chunk& chunk = chunks.back();
+		std::memcpy(static_cast<char*>(chunk.buffer->getMappedMemory()) + offset, data, static_cast<size_t>(size));
+		chunk.used = offset + size;
+		stagedBytes += size;
+
+		VkBufferCopy region{};
+		region.srcOffset = offset;
+		region.dstOffset = dstOffset;
+		region.size = size;
+		copies.push_back(Copy{ chunk.buffer->getBuffer(), dstBuffer, region });
+	}
+
+	void LveUploadBatch::submit()
+	{
+		if (commandBuffer != VK_NULL_HANDLE || copies.empty()) return;
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool = lveDevice.getCommandPool();
+		allocInfo.commandBufferCount = 1;
+		if (vkAllocateCommandBuffers(lveDevice.device(), &allocInfo, &commandBuffer) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to allocate upload command buffer!");
+		}
+
+		VkCommandBufferBeginInfo beginInfo{};
+		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		vkBeginCommandBuffer(commandBuffer, &beginInfo);
+		for (const Copy& copy : copies)
+		{
+			vkCmdCopyBuffer(commandBuffer, copy.srcBuffer, copy.dstBuffer, 1, &copy.region);
+		}
+		vkEndCommandBuffer(commandBuffer);
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		if (vkCreateFence(lveDevice.device(), &fenceInfo, nullptr, &fence) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to create upload fence!");
+		}
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+		submitInfo.pCommandBuffers = &commandBuffer;
+		if (vkQueueSubmit(lveDevice.graphicsQueue(), 1, &submitInfo, fence) != VK_SUCCESS)
+		{
+			throw std::runtime_error("failed to submit uploads!");
+		}
+	}
+
+	bool LveUploadBatch::isComplete() const
+	{
+		if (commandBuffer == VK_NULL_HANDLE) return copies.empty();
+		return vkGetFenceStatus(lveDevice.device(), fence) == VK_SUCCESS;
+	}
+
+	void LveUploadBatch::wait()
+	{
+		submit();
+		release();
+	}
+
+	void LveUploadBatch::release() noexcept
+	{
+		if (commandBuffer != VK_NULL_HANDLE)
+		{
+			// the result is ignored: if the device was lost there is nothing left to wait for
+			vkWaitForFences(lveDevice.device(), 1, &fence, VK_TRUE, UINT64_MAX);
+			vkDestroyFence(lveDevice.device(), fence, nullptr);
+			vkFreeCommandBuffers(lveDevice.device(), lveDevice.getCommandPool(), 1, &commandBuffer);
+			fence = VK_NULL_HANDLE;
+			commandBuffer = VK_NULL_HANDLE;
+		}
+
+		chunks.clear();
+		copies.clear();
+		stagedBytes = 0;
+	}
+} // namespace lve
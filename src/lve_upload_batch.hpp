@@ -0,0 +1,69 @@
+#pragma once
+
+#include "lve_buffer.hpp"
+#include "lve_device.hpp"
+
+// std
+#include <memory>
+#include <vector>
+
+namespace lve
+{
+	// Collects buffer uploads so they go to the GPU as one submit instead of one blocking submit each.
+	// copyToBuffer copies the data into shared host visible staging memory straight away (allocated in
+	// STAGING_CHUNK_SIZE chunks, so a whole scene's worth of meshes only needs a handful of allocations) and
+	// records the copy. submit() records every copy into one command buffer behind one fence, and wait()
+	// blocks on that fence and frees the staging memory.
+	// Destination buffers can't be used by the GPU until wait() has returned. Not thread safe, since it goes
+	// through the device's command pool and graphics queue
+	class LveUploadBatch
+	{
+	public:
+		static constexpr VkDeviceSize STAGING_CHUNK_SIZE = 16 * 1024 * 1024;
+
+		explicit LveUploadBatch(LveDevice& device);
+		// waits for anything still in flight. Never throws, and drops copies that haven't been submitted
+		~LveUploadBatch();
+
+		LveUploadBatch(const LveUploadBatch&) = delete;
+		LveUploadBatch& operator=(const LveUploadBatch&) = delete;
+
+		void copyToBuffer(const void* data, VkDeviceSize size, VkBuffer dstBuffer, VkDeviceSize dstOffset = 0);
+
+		// doesn't wait, so the CPU can get on with something else while the copies run
+		void submit();
+		// submits first if that hasn't happened yet. The batch can be reused afterwards
+		void wait();
+		// polls the fence instead of blocking. True once everything submitted has landed, and for an empty batch.
+		// wait() still has to be called to free the staging memory, but won't block by then
+		bool isComplete() const;
+
+		size_t getCopyCount() const { return copies.size(); }
+		VkDeviceSize getStagedBytes() const { return stagedBytes; }
+
+	private:
+		// waits on the fence if something was submitted, then frees everything
+		void release() noexcept;
+
+		struct Chunk
+		{
+			std::unique_ptr<LveBuffer> buffer;
+			VkDeviceSize used;
+		};
+
+		struct Copy
+		{
+			VkBuffer srcBuffer;
+			VkBuffer dstBuffer;
+			VkBufferCopy region;
+		};
+
+		LveDevice& lveDevice;
+		std::vector<Chunk> chunks;
+		std::vector<Copy> copies;
+		VkDeviceSize stagedBytes = 0;
+
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		VkFence fence = VK_NULL_HANDLE;
+	};
+} // namespace lve
@@ -0,0 +1,79 @@
+#pragma once
+
+// std
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lve
+{
+	// Maps OBJ index triples (position, normal, texcoord) to vertex indices while a model is built.
+	// An OBJ vertex is completely determined by which attributes it points at, so hashing three ints stands in
+	// for hashing and comparing every float of the vertex. Open addressing with linear probing in one flat array,
+	// sized up front for the number of corners so it never has to grow, and each corner is a single probe
+	// sequence that either finds its triple or claims the empty slot it ends on
+	class LveVertexIndexMap
+	{
+	public:
+		static constexpr uint32_t EMPTY = ~0u;
+
+		// maxKeys is an upper bound on the distinct triples, which the corner count always is
+		explicit LveVertexIndexMap(size_t maxKeys)
+		{
+			// at most two thirds full, and in practice far less since corners share vertices
+			size_t capacity = 16;
+			while (capacity < maxKeys + maxKeys / 2)
+			{
+				capacity *= 2;
+			}
+			slots.resize(capacity);
+			mask = capacity - 1;
+		}
+
+		// returns the vertex index for the triple, giving it newIndex if it hasn't been seen. inserted says which
+		uint32_t findOrInsert(int position, int normal, int texcoord, uint32_t newIndex, bool& inserted)
+		{
+			size_t slot = hash(position, normal, texcoord) & mask;
+			while (true)
+			{
+				Slot& entry = slots[slot];
+				if (entry.index == EMPTY)
+				{
+					entry = Slot{ position, normal, texcoord, newIndex };
+					inserted = true;
+					return newIndex;
+				}
+				if (entry.position == position && entry.normal == normal && entry.texcoord == texcoord)
+				{
+					inserted = false;
+					return entry.index;
+				}
+				slot = (slot + 1) & mask;
+			}
+		}
+
+	private:
+		struct Slot
+		{
+			int32_t position;
+			int32_t normal;
+			int32_t texcoord;
+			uint32_t index = EMPTY;
+		};
+
+		static size_t hash(int position, int normal, int texcoord)
+		{
+			// the indices are small and close together, so mix them well enough that neighbours don't cluster
+			uint64_t h = static_cast<uint32_t>(position) * 0x9e3779b97f4a7c15ull;
+			h ^= static_cast<uint32_t>(normal) * 0xc2b2ae3d27d4eb4full;
+			h ^= static_cast<uint32_t>(texcoord) * 0x165667b19e3779f9ull;
+			h ^= h >> 32;
+			h *= 0xff51afd7ed558ccdull;
+			h ^= h >> 29;
+			return static_cast<size_t>(h);
+		}
+
+		std::vector<Slot> slots;
+		size_t mask;
+	};
+} // namespace lve
@@ -5,9 +5,26 @@
 #include <cstdlib>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 
-int main() {
-  lve::App app{};
+// usage: game [--record file] [--replay file] [--scene file]
+int main(int argc, char *argv[]) {
+  lve::App::Options options{};
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string flag = argv[i];
+    if (flag == "--record") {
+      options.recordPath = argv[i + 1];
+    } else if (flag == "--replay") {
+      options.replayPath = argv[i + 1];
+    } else if (flag == "--scene") {
+      options.scenePath = argv[i + 1];
+    } else {
+      std::cerr << "unknown option: " << flag << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+
+  lve::App app{options};
 
   try {
     app.run();
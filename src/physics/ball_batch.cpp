@@ -0,0 +1,289 @@
+#include "ball_batch.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LVE_BATCH_SSE2
+#endif
+
+namespace lve
+{
+    BallBatch::BallBatch(CourseWorld& world, LveThreadPool& threadPool)
+        : BallBatch(world, threadPool, BallSimulation::Settings{})
+    {
+    }
+
+    BallBatch::BallBatch(CourseWorld& world, LveThreadPool& threadPool, const BallSimulation::Settings& settings)
+        : world{ world }, threadPool{ threadPool }, settings{ settings }
+    {
+        workers.resize(threadPool.getConcurrency());
+        for (Worker& worker : workers)
+        {
+            worker.simulation = std::make_unique<BallSimulation>(world, settings);
+        }
+    }
+
+    BallBatch::BallId BallBatch::addBall(glm::vec3 position, int courseIndex)
+    {
+        positionX.push_back(position.x);
+        positionY.push_back(position.y);
+        positionZ.push_back(position.z);
+        velocityX.push_back(0.0f);
+        velocityY.push_back(0.0f);
+        velocityZ.push_back(0.0f);
+        previousX.push_back(position.x);
+        previousY.push_back(position.y);
+        previousZ.push_back(position.z);
+        restTime.push_back(0.0f);
+        course.push_back(courseIndex);
+        flags.push_back(GROUNDED);
+        return static_cast<BallId>(flags.size() - 1);
+    }
+
+    void BallBatch::clear()
+    {
+        for (auto* array : { &positionX, &positionY, &positionZ, &velocityX, &velocityY, &velocityZ,
+            &previousX, &previousY, &previousZ, &restTime })
+        {
+            array->clear();
+        }
+        course.clear();
+        flags.clear();
+    }
+
+    BallState BallBatch::getState(BallId ball) const
+    {
+        BallState state{};
+        state.position = { positionX[ball], positionY[ball], positionZ[ball] };
+        state.velocity = { velocityX[ball], velocityY[ball], velocityZ[ball] };
+        state.previousPos = { previousX[ball], previousY[ball], previousZ[ball] };
+        state.currentCourse = course[ball];
+        state.moving = (flags[ball] & MOVING) != 0;
+        state.grounded = (flags[ball] & GROUNDED) != 0;
+        state.sleep.asleep = (flags[ball] & ASLEEP) != 0;
+        state.sleep.restTime = restTime[ball];
+        return state;
+    }
+
+    void BallBatch::setState(BallId ball, const BallState& state)
+    {
+        positionX[ball] = state.position.x;
+        positionY[ball] = state.position.y;
+        positionZ[ball] = state.position.z;
+        velocityX[ball] = state.velocity.x;
+        velocityY[ball] = state.velocity.y;
+        velocityZ[ball] = state.velocity.z;
+        previousX[ball] = state.previousPos.x;
+        previousY[ball] = state.previousPos.y;
+        previousZ[ball] = state.previousPos.z;
+        course[ball] = state.currentCourse;
+        restTime[ball] = state.sleep.restTime;
+
+        uint32_t f = flags[ball] & EVENTS;
+        if (state.moving) f |= MOVING;
+        if (state.grounded) f |= GROUNDED;
+        if (state.sleep.asleep) f |= ASLEEP;
+        flags[ball] = f;
+    }
+
+    void BallBatch::launch(BallId ball, const ShotCommand& shot)
+    {
+        BallState state = getState(ball);
+        workers[0].simulation->launch(state, shot);
+        setState(ball, state);
+    }
+
+    size_t BallBatch::getAwakeCount() const
+    {
+        return static_cast<size_t>(std::count_if(flags.begin(), flags.end(), [](uint32_t f) { return (f & ASLEEP) == 0; }));
+    }
+
+    void BallBatch::step(float dt)
+    {
+        // every range gets its own worker slot, so size the ranges to match the worker count
+        size_t rangeSize = std::max(minRange, (size() + workers.size() - 1) / workers.size());
+        size_t rangeCount = (size() + rangeSize - 1) / rangeSize;
+
+        threadPool.parallelFor(rangeCount, 1, [&](size_t firstRange, size_t lastRange)
+        {
+            for (size_t range = firstRange; range < lastRange; range++)
+            {
+                size_t begin = range * rangeSize;
+                size_t end = std::min(begin + rangeSize, size());
+                integrateRange(begin, end, dt);
+                collideRange(workers[range], begin, end, dt);
+            }
+        });
+    }
+
+    void BallBatch::integrateRange(size_t begin, size_t end, float dt)
+    {
+        // same motion as BallSimulation::integrate, with the drag term folded into one scale factor:
+        // v -= (v / |v| * drag + v * friction) * dt  ==  v -= v * (drag / |v| + friction) * dt
+        const float gravityStep = settings.gravity * dt;
+        size_t i = begin;
+
+#ifdef LVE_BATCH_SSE2
+        const __m128 dtv = _mm_set1_ps(dt);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 drag = _mm_set1_ps(settings.drag);
+        const __m128 friction = _mm_set1_ps(settings.friction);
+        const __m128 gravity = _mm_set1_ps(gravityStep);
+        const __m128i movingBit = _mm_set1_epi32(MOVING);
+        const __m128i groundedBit = _mm_set1_epi32(GROUNDED);
+
+        for (; i + 4 <= end; i += 4)
+        {
+            __m128i f = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&flags[i]));
+            __m128i movingInt = _mm_cmpeq_epi32(_mm_and_si128(f, movingBit), movingBit);
+            __m128 moving = _mm_castsi128_ps(movingInt);
+            // sleeping and resting balls never have the moving flag, so whole groups of them are skipped
+            if (_mm_movemask_ps(moving) == 0)
+            {
+                continue;
+            }
+            __m128 grounded = _mm_and_ps(moving,
+                _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(f, groundedBit), groundedBit)));
+
+            __m128 vx = _mm_loadu_ps(&velocityX[i]);
+            __m128 vy = _mm_loadu_ps(&velocityY[i]);
+            __m128 vz = _mm_loadu_ps(&velocityZ[i]);
+
+            __m128 speedSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz));
+            __m128 hasSpeed = _mm_cmpgt_ps(speedSquared, zero);
+            // lanes with no speed get a safe divisor and are masked out below
+            __m128 speed = _mm_sqrt_ps(_mm_or_ps(_mm_and_ps(hasSpeed, speedSquared), _mm_andnot_ps(hasSpeed, one)));
+            __m128 loss = _mm_mul_ps(_mm_add_ps(_mm_div_ps(drag, speed), friction), dtv);
+            loss = _mm_and_ps(loss, _mm_and_ps(grounded, hasSpeed));
+
+            vx = _mm_sub_ps(vx, _mm_mul_ps(vx, loss));
+            vy = _mm_sub_ps(vy, _mm_mul_ps(vy, loss));
+            vz = _mm_sub_ps(vz, _mm_mul_ps(vz, loss));
+            vy = _mm_add_ps(vy, _mm_and_ps(gravity, moving));
+
+            __m128 step = _mm_and_ps(dtv, moving);
+            _mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(vx, step)));
+            _mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(vy, step)));
+            _mm_storeu_ps(&positionZ[i], _mm_add_ps(_mm_loadu_ps(&positionZ[i]), _mm_mul_ps(vz, step)));
+            _mm_storeu_ps(&velocityX[i], vx);
+            _mm_storeu_ps(&velocityY[i], vy);
+            _mm_storeu_ps(&velocityZ[i], vz);
+
+            // moving balls are only grounded again if this tick's contacts say so
+            f = _mm_andnot_si128(_mm_and_si128(movingInt, groundedBit), f);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&flags[i]), f);
+        }
+#endif
+
+        for (; i < end; i++)
+        {
+            if ((flags[i] & MOVING) == 0)
+            {
+                continue;
+            }
+
+            if (flags[i] & GROUNDED)
+            {
+                float speed = std::sqrt(velocityX[i] * velocityX[i] + velocityY[i] * velocityY[i] + velocityZ[i] * velocityZ[i]);
+                if (speed > 0.0f)
+                {
+                    float loss = (settings.drag / speed + settings.friction) * dt;
+                    velocityX[i] -= velocityX[i] * loss;
+                    velocityY[i] -= velocityY[i] * loss;
+                    velocityZ[i] -= velocityZ[i] * loss;
+                }
+                flags[i] &= ~GROUNDED;
+            }
+            velocityY[i] += gravityStep;
+
+            positionX[i] += velocityX[i] * dt;
+            positionY[i] += velocityY[i] * dt;
+            positionZ[i] += velocityZ[i] * dt;
+        }
+    }
+
+    void BallBatch::collideRange(Worker& worker, size_t begin, size_t end, float dt)
+    {
+        BallSimulation& simulation = *worker.simulation;
+        const float radius = settings.radius;
+
+        // broadphase for the whole range first, packed into one flat candidate list
+        worker.active.clear();
+        worker.candidates.clear();
+        worker.candidateOffsets.clear();
+        for (size_t i = begin; i < end; i++)
+        {
+            flags[i] &= ~EVENTS;
+            if (flags[i] & ASLEEP)
+            {
+                continue;
+            }
+
+            if (positionY[i] > settings.resetHeight)
+            {
+                BallState state = getState(static_cast<BallId>(i));
+                simulation.resetBall(state);
+                setState(static_cast<BallId>(i), state);
+                flags[i] |= RESET;
+                continue;
+            }
+
+            AABB bounds = { 0, glm::vec2(positionX[i] - radius, positionZ[i] - radius),
+                glm::vec2(positionX[i] + radius, positionZ[i] + radius) };
+            worker.active.push_back(static_cast<BallId>(i));
+            worker.candidateOffsets.push_back(static_cast<uint32_t>(worker.candidates.size()));
+            world.collisionManager.RetrieveCandidates(bounds, worker.candidates);
+        }
+        worker.candidateOffsets.push_back(static_cast<uint32_t>(worker.candidates.size()));
+
+        // then narrowphase and contact solving ball by ball. Warm starting needs per-ball contact history,
+        // which isn't kept here, so the solver starts cold for every ball
+        for (size_t a = 0; a < worker.active.size(); a++)
+        {
+            BallId ball = worker.active[a];
+            BallState state = getState(ball);
+            SphereCollider& sphere = simulation.getCollider(state);
+
+            worker.contacts.clear();
+            for (uint32_t c = worker.candidateOffsets[a]; c < worker.candidateOffsets[a + 1]; c++)
+            {
+                Collision collision{};
+                if (world.collisionManager.GetCollision(worker.candidates[c], sphere, collision))
+                {
+                    worker.contacts.push_back(collision);
+                }
+            }
+
+            bool wasMoving = state.moving;
+            BallSimulation::StepResult result{};
+            simulation.resetContactCache();
+            simulation.resolveContacts(state, worker.contacts, result);
+            if (!result.reset)
+            {
+                result.holed = simulation.checkGoal(state);
+            }
+
+            // every ball is its own island, since balls in a batch never touch each other
+            if (glm::dot(state.velocity, state.velocity) > sleepSettings.sleepVelocity * sleepSettings.sleepVelocity)
+            {
+                state.sleep.restTime = 0.0f;
+            }
+            else
+            {
+                state.sleep.restTime += dt;
+            }
+            if (!state.moving && state.sleep.restTime >= sleepSettings.timeToSleep)
+            {
+                state.sleep.asleep = true;
+            }
+
+            setState(ball, state);
+            if (wasMoving && !state.moving) flags[ball] |= STOPPED;
+            if (result.holed) flags[ball] |= HOLED;
+            if (result.reset) flags[ball] |= RESET;
+        }
+    }
+}
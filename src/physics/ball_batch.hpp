@@ -0,0 +1,86 @@
+#pragma once
+
+#include "ball_simulation.hpp"
+#include "course_world.hpp"
+#include "island_manager.hpp"
+#include "../collision/collision.hpp"
+#include "../lve_thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lve
+{
+    // Simulates many independent balls at once, e.g. a driving range or bulk replay validation.
+    // Ball data is stored as structure-of-arrays so integration can run 4 balls per SIMD instruction,
+    // and the batch is split into contiguous ranges that run on the thread pool.
+    // Balls don't collide with each other, only with the course
+    class BallBatch
+    {
+    public:
+        using BallId = uint32_t;
+
+        enum Flags : uint32_t
+        {
+            MOVING = 1 << 0,
+            GROUNDED = 1 << 1,
+            ASLEEP = 1 << 2,
+            // events from the last step, cleared at the start of every step
+            STOPPED = 1 << 3,
+            HOLED = 1 << 4,
+            RESET = 1 << 5,
+            EVENTS = STOPPED | HOLED | RESET,
+        };
+
+        BallBatch(CourseWorld& world, LveThreadPool& threadPool);
+        BallBatch(CourseWorld& world, LveThreadPool& threadPool, const BallSimulation::Settings& settings);
+
+        BallId addBall(glm::vec3 position, int course);
+        void clear();
+
+        void launch(BallId ball, const ShotCommand& shot);
+        void step(float dt);
+
+        // gather or scatter a single ball. Fine for setup, but too slow for per-tick use on the whole batch
+        BallState getState(BallId ball) const;
+        void setState(BallId ball, const BallState& state);
+
+        size_t size() const { return flags.size(); }
+        uint32_t getFlags(BallId ball) const { return flags[ball]; }
+        glm::vec3 getPosition(BallId ball) const { return { positionX[ball], positionY[ball], positionZ[ball] }; }
+        size_t getAwakeCount() const;
+
+        // balls per range handed to a worker
+        size_t minRange = 256;
+        IslandManager::Settings sleepSettings{};
+
+    private:
+        // per-range scratch space, so workers never share anything mutable
+        struct Worker
+        {
+            std::unique_ptr<BallSimulation> simulation;
+            std::vector<int> candidates;
+            std::vector<uint32_t> candidateOffsets;
+            std::vector<BallId> active;
+            std::vector<Collision> contacts;
+        };
+
+        void integrateRange(size_t begin, size_t end, float dt);
+        void collideRange(Worker& worker, size_t begin, size_t end, float dt);
+
+        CourseWorld& world;
+        LveThreadPool& threadPool;
+        BallSimulation::Settings settings;
+        std::vector<Worker> workers;
+
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> velocityX, velocityY, velocityZ;
+        std::vector<float> previousX, previousY, previousZ;
+        std::vector<float> restTime;
+        std::vector<int32_t> course;
+        std::vector<uint32_t> flags;
+    };
+}
@@ -0,0 +1,260 @@
+#include "ball_simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lve
+{
+    BallSimulation::BallSimulation(CourseWorld& world)
+        : BallSimulation(world, Settings{})
+    {
+    }
+
+    BallSimulation::BallSimulation(CourseWorld& world, const Settings& settings)
+        : world{ world }, settings{ settings }, collider{ glm::vec3{ 0.0f }, settings.radius }
+    {
+    }
+
+    void BallSimulation::launch(BallState& state, const ShotCommand& shot)
+    {
+        // y points down, so a positive pitch launches the ball upwards
+        float horizontal = std::cos(shot.pitch);
+        state.velocity = glm::vec3{
+            std::sin(shot.yaw) * horizontal,
+            -std::sin(shot.pitch),
+            std::cos(shot.yaw) * horizontal } * shot.power;
+        state.moving = true;
+        state.sleep.wake();
+    }
+
+    BallSimulation::StepResult BallSimulation::step(BallState& state, float dt)
+    {
+        StepResult result{};
+
+        if (state.position.y > settings.resetHeight)
+        {
+            resetBall(state);
+            result.reset = true;
+            return result;
+        }
+
+        if (state.sleep.asleep)
+        {
+            // the ball's island went to sleep, so treat it as stopped and skip it entirely
+            state.moving = false;
+            return result;
+        }
+
+        bool wasMoving = state.moving;
+        integrate(state, dt);
+        findContacts(state, contacts);
+        resolveContacts(state, contacts, result);
+
+        if (wasMoving && !state.moving)
+        {
+            result.stopped = true;
+        }
+
+        if (!result.reset)
+        {
+            result.holed = checkGoal(state);
+        }
+
+        return result;
+    }
+
+    BallSimulation::StepResult BallSimulation::tick(BallState& state, const TickInput& input)
+    {
+        if (input.launch && !state.moving)
+        {
+            launch(state, ShotCommand{ input.aim.y, 0.0f, input.power });
+        }
+        return step(state, input.dt);
+    }
+
+    BallSimulation::StepResult BallSimulation::advance(BallState& state, float dt, float maxTime, float& elapsed)
+    {
+        // grounded means the ball touched the floor last step, so it's rolling or resting rather than flying
+        if (!state.moving || state.grounded || state.sleep.asleep || state.position.y > settings.resetHeight)
+        {
+            elapsed = dt;
+            return step(state, dt);
+        }
+
+        float impact = maxTime > dt ? findTimeOfImpact(state, maxTime) : 0.0f;
+        if (impact < 2.0f * dt)
+        {
+            // about to touch something (or out of time), so there's nothing worth skipping
+            elapsed = dt;
+            return step(state, dt);
+        }
+
+        // stop a step short of the impact so the contact gets resolved by a normal step
+        float flight = (impact < maxTime) ? impact - dt : maxTime;
+        state.position += state.velocity * flight + glm::vec3{ 0.0f, 0.5f * settings.gravity * flight * flight, 0.0f };
+        state.velocity.y += settings.gravity * flight;
+
+        elapsed = flight;
+        return StepResult{};
+    }
+
+    float BallSimulation::findTimeOfImpact(const BallState& state, float maxTime)
+    {
+        glm::vec3 acceleration{ 0.0f, settings.gravity, 0.0f };
+
+        // the ball always comes down eventually, so the reset plane also bounds how far the arc can go
+        float impact = maxTime;
+        float a = 0.5f * settings.gravity;
+        float c = state.position.y - settings.resetHeight;
+        float discriminant = state.velocity.y * state.velocity.y - 4.0f * a * c;
+        if (a > 0.0f && discriminant >= 0.0f)
+        {
+            float t = (-state.velocity.y + std::sqrt(discriminant)) / (2.0f * a);
+            if (t >= 0.0f)
+            {
+                impact = std::min(impact, t);
+            }
+        }
+
+        // nothing slows the ball down in the air, so it moves in a straight line across the ground plane
+        glm::vec3 end = state.position + state.velocity * impact;
+        float r = settings.radius;
+        AABB bounds{ 0,
+            glm::vec2{ std::min(state.position.x, end.x) - r, std::min(state.position.z, end.z) - r },
+            glm::vec2{ std::max(state.position.x, end.x) + r, std::max(state.position.z, end.z) + r } };
+
+        candidates.clear();
+        world.collisionManager.RetrieveCandidates(bounds, candidates);
+
+        for (int i : candidates)
+        {
+            float t;
+            if (world.collisionManager.GetTimeOfImpact(i, state.position, state.velocity, acceleration, r, impact, t))
+            {
+                impact = t;
+            }
+        }
+
+        return impact;
+    }
+
+    bool BallSimulation::checkGoal(BallState& state)
+    {
+        if (!state.moving && world.goals[state.currentCourse].CollidesWith(getCollider(state)))
+        {
+            nextHole(state);
+            return true;
+        }
+        return false;
+    }
+
+    void BallSimulation::integrate(BallState& state, float dt)
+    {
+        if (!state.moving)
+        {
+            return;
+        }
+
+        if (state.grounded)
+        {
+            float speed = glm::length(state.velocity);
+            if (speed > 0.0f)
+            {
+                glm::vec3 loss = state.velocity / speed;
+                state.velocity = state.velocity - ((loss * settings.drag + state.velocity * settings.friction) * dt);
+            }
+            state.grounded = false;
+        }
+        state.velocity.y += settings.gravity * dt;
+
+        state.position += state.velocity * dt;
+    }
+
+    void BallSimulation::findContacts(const BallState& state, std::vector<Collision>& contacts)
+    {
+        contacts.clear();
+        world.collisionManager.GetCollisions(getCollider(state), &BallSimulation::ForwardOnCollision, &contacts);
+    }
+
+    void BallSimulation::resolveContacts(BallState& state, std::vector<Collision>& contacts, StepResult& result)
+    {
+        if (contacts.empty())
+        {
+            contactSolver.reset();
+            return;
+        }
+
+        // all floors should be soft and all walls bouncy
+        for (Collision& contact : contacts)
+        {
+            contact.restitution = (contact.normal.y <= -0.6f) ? settings.floorRestitution : settings.wallRestitution;
+            if (glm::dot(state.velocity, contact.normal) < -contactSolver.settings.restitutionThreshold)
+            {
+                result.bounced = true;
+            }
+        }
+
+        contactSolver.solve(contacts, state.position, state.velocity);
+
+        const Collision* floor = nullptr;
+        for (const Collision& contact : contacts)
+        {
+            if (contact.normal.y <= -0.99)
+            {
+                floor = &contact;
+                break;
+            }
+        }
+
+        if (floor == nullptr)
+        {
+            return;
+        }
+
+        state.grounded = true;
+
+        if (glm::dot(state.velocity, state.velocity) < settings.stopSpeedSquared)
+        {
+            state.moving = false;
+
+            // stopping on another hole's turf puts the ball back where it was
+            if (floor->courseIndex >= 0 && floor->courseIndex != state.currentCourse)
+            {
+                resetBall(state);
+                result.reset = true;
+            }
+            else
+            {
+                state.previousPos = state.position;
+            }
+        }
+    }
+
+    SphereCollider& BallSimulation::getCollider(const BallState& state)
+    {
+        collider.position = state.position;
+        return collider;
+    }
+
+    void BallSimulation::resetBall(BallState& state, glm::vec3 position)
+    {
+        state.previousPos = position;
+        resetBall(state);
+    }
+
+    void BallSimulation::resetBall(BallState& state)
+    {
+        state.moving = false;
+        state.grounded = true;
+        state.velocity = { 0.0f, 0.0f, 0.0f };
+        state.position = state.previousPos;
+        state.sleep.wake();
+        contactSolver.reset();
+    }
+
+    void BallSimulation::nextHole(BallState& state)
+    {
+        state.currentCourse = (state.currentCourse + 1) % world.getHoleCount();
+        resetBall(state, world.tees[state.currentCourse]);
+    }
+}
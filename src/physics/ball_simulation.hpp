@@ -0,0 +1,140 @@
+#pragma once
+
+#include "contact_solver.hpp"
+#include "course_world.hpp"
+#include "island_manager.hpp"
+#include "../collision/collision.hpp"
+#include "../collision/sphere_collider.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace lve
+{
+    // complete physical state of one golf ball. Plain data so it can be copied around freely
+    struct BallState
+    {
+        glm::vec3 position{ 0.0f };
+        glm::vec3 velocity{ 0.0f };
+        // last position the ball came to rest on its own hole. Used when the ball has to be reset
+        glm::vec3 previousPos{ 0.0f };
+        int currentCourse = 0;
+
+        bool moving = false;
+        bool grounded = false;
+
+        SleepState sleep{};
+    };
+
+    struct ShotCommand
+    {
+        // horizontal direction of the shot, in radians
+        float yaw = 0.0f;
+        // elevation above the ground, in radians. 0 is a flat putt
+        float pitch = 0.0f;
+        // launch speed
+        float power = 0.0f;
+    };
+
+    // everything the player did in one tick, as far as the ball is concerned. Recording these (and the tick
+    // lengths) is enough to replay a round exactly
+    struct TickInput
+    {
+        float dt = 0.0f;
+        // x is the camera pitch, y is the aiming yaw
+        glm::vec2 aim{ 0.0f };
+        float power = 0.0f;
+        bool aiming = false;
+        // hit the ball this tick, using aim.y and power
+        bool launch = false;
+        // switch between the ball camera and the free camera
+        bool toggleCamera = false;
+    };
+
+    // Ball physics with no window, input or renderer attached. Takes a ball state and a course and
+    // produces the next state. The game drives it through GolfBallController, and the headless
+    // simulator drives it directly
+    class BallSimulation
+    {
+    public:
+        struct Settings
+        {
+            float radius = 0.06f;
+            float gravity = 14.7f;
+            float friction = 0.6f;
+            float drag = 0.1f;
+            float floorRestitution = 0.55f;
+            float wallRestitution = 0.95f;
+            // the ball is considered stopped once it's grounded and its squared speed drops below this
+            float stopSpeedSquared = 0.005f;
+            // ball reset plane. y points down, so this is below the course
+            float resetHeight = 10.0f;
+        };
+
+        // what happened during a single step
+        struct StepResult
+        {
+            bool stopped = false;
+            bool holed = false;
+            bool reset = false;
+            // the ball hit something hard enough to bounce, rather than resting or rolling on it
+            bool bounced = false;
+        };
+
+        BallSimulation(CourseWorld& world);
+        BallSimulation(CourseWorld& world, const Settings& settings);
+
+        void launch(BallState& state, const ShotCommand& shot);
+        StepResult step(BallState& state, float dt);
+        // launches the ball if the input asks for it, then steps by the input's dt. The game and replays
+        // both go through here so they can't drift apart
+        StepResult tick(BallState& state, const TickInput& input);
+
+        // Event driven alternative to step, for offline shot evaluation. While the ball is flying it follows the exact
+        // parabola straight to the next possible impact (or maxTime) instead of stepping there. Rolling, resting and
+        // the contacts themselves still take a normal step of dt. elapsed is how much time actually passed
+        StepResult advance(BallState& state, float dt, float maxTime, float& elapsed);
+        // earliest time the flying ball could touch a course collider or reach the reset plane, or maxTime if neither
+        float findTimeOfImpact(const BallState& state, float maxTime);
+
+        // put the ball back on its last resting spot
+        void resetBall(BallState& state);
+        void resetBall(BallState& state, glm::vec3 position);
+        void nextHole(BallState& state);
+
+        // the ball's collider placed at the given state
+        SphereCollider& getCollider(const BallState& state);
+
+        // the pieces of step(), for callers that run the phases over many balls themselves
+        void integrate(BallState& state, float dt);
+        void findContacts(const BallState& state, std::vector<Collision>& contacts);
+        void resolveContacts(BallState& state, std::vector<Collision>& contacts, StepResult& result);
+        // moves on to the next hole if the ball has stopped inside the goal
+        bool checkGoal(BallState& state);
+        // forget warm starting data, e.g. before handling a different ball
+        void resetContactCache() { contactSolver.reset(); }
+        // warm starting data is part of the simulation state, so rollbacks have to save and restore it to resimulate exactly
+        void saveContactCache(ContactSolver::WarmStartCache& cache) const { contactSolver.saveCache(cache); }
+        void restoreContactCache(const ContactSolver::WarmStartCache& cache) { contactSolver.restoreCache(cache); }
+
+        CourseWorld& getWorld() { return world; }
+        const Settings& getSettings() const { return settings; }
+
+    private:
+        static void ForwardOnCollision(void* context, Collision collision)
+        {
+            static_cast<std::vector<Collision>*>(context)->push_back(collision);
+        }
+
+        CourseWorld& world;
+        Settings settings;
+
+        SphereCollider collider;
+        ContactSolver contactSolver{};
+        // contact manifold for the current step
+        std::vector<Collision> contacts;
+        // broadphase results for the time of impact queries
+        std::vector<int> candidates;
+    };
+}
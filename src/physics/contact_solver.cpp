@@ -0,0 +1,136 @@
+#include "contact_solver.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace lve
+{
+    float ContactSolver::findWarmStartImpulse(const ContactConstraint& constraint) const
+    {
+        if (constraint.colliderIndex < 0)
+        {
+            return 0.0f;
+        }
+
+        for (const ContactConstraint& cached : cachedConstraints)
+        {
+            if (cached.courseIndex == constraint.courseIndex && cached.colliderIndex == constraint.colliderIndex
+                && glm::dot(cached.normal, constraint.normal) > settings.warmStartNormalTolerance)
+            {
+                return cached.normalImpulse * settings.warmStartFactor;
+            }
+        }
+        return 0.0f;
+    }
+
+    int ContactSolver::solve(const std::vector<Collision>& contacts, glm::vec3& position, glm::vec3& velocity)
+    {
+        constraints.clear();
+
+        // set up the constraints. The bounce target is taken from the velocity before any impulses are
+        // applied, otherwise the order of contacts would change how hard the ball bounces
+        for (const Collision& contact : contacts)
+        {
+            ContactConstraint constraint{};
+            constraint.courseIndex = contact.courseIndex;
+            constraint.colliderIndex = contact.colliderIndex;
+            constraint.normal = contact.normal;
+            constraint.depth = contact.depth;
+
+            float normalVelocity = glm::dot(velocity, contact.normal);
+            if (normalVelocity < -settings.restitutionThreshold)
+            {
+                constraint.velocityBias = -contact.restitution * normalVelocity;
+            }
+
+            constraints.push_back(constraint);
+        }
+
+        // warm start with last tick's impulses. For a resting ball this cancels gravity straight away
+        for (ContactConstraint& constraint : constraints)
+        {
+            constraint.normalImpulse = findWarmStartImpulse(constraint);
+            velocity += constraint.normal * constraint.normalImpulse;
+        }
+
+        // the ball has (effectively) no mass compared to the static world, so the effective mass along
+        // every contact normal is 1 and impulses map directly to velocity changes
+        int iteration = 0;
+        for (; iteration < settings.velocityIterations; iteration++)
+        {
+            float maxDelta = 0.0f;
+            for (ContactConstraint& constraint : constraints)
+            {
+                float normalVelocity = glm::dot(velocity, constraint.normal);
+                float lambda = constraint.velocityBias - normalVelocity;
+
+                // clamp the accumulated impulse rather than the per-iteration one, so earlier
+                // iterations can be partially undone when another contact takes over the load
+                float newImpulse = std::max(constraint.normalImpulse + lambda, 0.0f);
+                lambda = newImpulse - constraint.normalImpulse;
+                constraint.normalImpulse = newImpulse;
+
+                velocity += constraint.normal * lambda;
+                maxDelta = std::max(maxDelta, std::abs(lambda));
+            }
+
+            if (maxDelta < settings.impulseTolerance)
+            {
+                iteration++;
+                break;
+            }
+        }
+
+        // push the ball out of penetration. Corrections are accumulated so two walls in a corner
+        // share the push instead of each moving the ball by its full depth
+        glm::vec3 correction{ 0.0f };
+        for (int i = 0; i < settings.positionIterations; i++)
+        {
+            for (const ContactConstraint& constraint : constraints)
+            {
+                float remaining = constraint.depth - glm::dot(correction, constraint.normal);
+                if (remaining > 0.0f)
+                {
+                    correction += constraint.normal * remaining;
+                }
+            }
+        }
+        position += correction;
+
+        cachedConstraints = constraints;
+
+        return iteration;
+    }
+
+    void ContactSolver::saveCache(WarmStartCache& cache) const
+    {
+        cache.count = 0;
+        for (const ContactConstraint& cached : cachedConstraints)
+        {
+            if (cache.count == MAX_CACHED_CONTACTS)
+            {
+                break;
+            }
+            cache.courseIndices[cache.count] = cached.courseIndex;
+            cache.colliderIndices[cache.count] = cached.colliderIndex;
+            cache.normals[cache.count] = cached.normal;
+            cache.impulses[cache.count] = cached.normalImpulse;
+            cache.count++;
+        }
+    }
+
+    void ContactSolver::restoreCache(const WarmStartCache& cache)
+    {
+        cachedConstraints.clear();
+        for (int i = 0; i < cache.count; i++)
+        {
+            // only the collider, normal and impulse are used for matching next tick
+            ContactConstraint constraint{};
+            constraint.courseIndex = cache.courseIndices[i];
+            constraint.colliderIndex = cache.colliderIndices[i];
+            constraint.normal = cache.normals[i];
+            constraint.normalImpulse = cache.impulses[i];
+            cachedConstraints.push_back(constraint);
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "../collision/collision.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace lve
+{
+    // Sequential impulse solver for a single dynamic sphere touching any number of static colliders.
+    // All contacts for a tick are gathered first and then solved together, so corners with two or three
+    // simultaneous contacts settle instead of fighting each other one callback at a time.
+    // Accumulated impulses are kept from the previous tick and used to warm start the next solve.
+    class ContactSolver
+    {
+    public:
+        struct Settings
+        {
+            int velocityIterations = 8;
+            int positionIterations = 4;
+            // approach speeds below this are treated as resting contact and don't bounce
+            float restitutionThreshold = 0.5f;
+            // fraction of last tick's impulse re-applied before iterating
+            float warmStartFactor = 0.9f;
+            // contacts from last tick match when they come from the same collider with a similar normal
+            float warmStartNormalTolerance = 0.95f;
+            // iterations stop early once no contact changes by more than this
+            float impulseTolerance = 1e-4f;
+        };
+
+        // the warm starting data as a fixed size block, for world snapshots. A ball rarely touches more than
+        // a handful of colliders, anything past the limit just starts cold after a restore
+        static constexpr int MAX_CACHED_CONTACTS = 8;
+        struct WarmStartCache
+        {
+            int count = 0;
+            // colliders by hole and index rather than address, so a cache stays valid when the world's colliders
+            // are rebuilt
+            int courseIndices[MAX_CACHED_CONTACTS];
+            int colliderIndices[MAX_CACHED_CONTACTS];
+            glm::vec3 normals[MAX_CACHED_CONTACTS];
+            float impulses[MAX_CACHED_CONTACTS];
+        };
+
+        // resolves all contacts in place. Position is pushed out of penetration and velocity has its
+        // approaching components removed (with restitution). Returns the number of velocity iterations used
+        int solve(const std::vector<Collision>& contacts, glm::vec3& position, glm::vec3& velocity);
+
+        // forget the warm starting cache, e.g. after the ball is teleported
+        void reset() { cachedConstraints.clear(); }
+
+        void saveCache(WarmStartCache& cache) const;
+        void restoreCache(const WarmStartCache& cache);
+
+        Settings settings{};
+
+    private:
+        struct ContactConstraint
+        {
+            int courseIndex;
+            int colliderIndex;
+            glm::vec3 normal;
+            float depth;
+            float velocityBias;
+            float normalImpulse;
+        };
+
+        float findWarmStartImpulse(const ContactConstraint& constraint) const;
+
+        std::vector<ContactConstraint> constraints;
+        std::vector<ContactConstraint> cachedConstraints;
+    };
+}
@@ -0,0 +1,73 @@
+#include "course_world.hpp"
+
+namespace lve
+{
+    void CourseWorld::loadDefaultCourse()
+    {
+        loadCourse(SceneDescription::load(DEFAULT_COURSE));
+    }
+
+    void CourseWorld::loadCourse(const SceneDescription& description)
+    {
+        std::vector<std::vector<BoxCollider>> collidersPerHole{};
+        for (const SceneDescription::Hole& hole : description.holes)
+        {
+            collidersPerHole.push_back(CollisionManager::readCollidersFromFile(hole.colliderFile));
+        }
+        loadCourse(description, collidersPerHole);
+    }
+
+    void CourseWorld::loadCourse(const SceneDescription& description, const std::vector<std::vector<BoxCollider>>& collidersPerHole)
+    {
+        for (size_t i = 0; i < description.holes.size(); i++)
+        {
+            const SceneDescription::Hole& hole = description.holes[i];
+            addHoleColliders(collidersPerHole[i], static_cast<int>(i));
+
+            tees.push_back(hole.tee);
+            goals.push_back(BoxCollider(hole.goal,
+                {1.0f, 0.0f, 0.0f, hole.goalSize.x},
+                {0.0f, 0.0f, 1.0f, hole.goalSize.z},
+                {0.0f, 1.0f, 0.0f, hole.goalSize.y}));
+        }
+
+        build();
+    }
+
+    void CourseWorld::loadHoleColliders(const std::string& filename, int courseIndex)
+    {
+        addHoleColliders(CollisionManager::readCollidersFromFile(filename), courseIndex);
+    }
+
+    void CourseWorld::addHoleColliders(const std::vector<BoxCollider>& newColliders, int courseIndex)
+    {
+        if (courseIndex >= static_cast<int>(holeColliders.size()))
+        {
+            holeColliders.resize(courseIndex + 1);
+        }
+        for (BoxCollider bc : newColliders)
+        {
+            bc.courseIndex = courseIndex;
+            bc.colliderIndex = static_cast<int>(holeColliders[courseIndex].size());
+            holeColliders[courseIndex].push_back(bc);
+        }
+    }
+
+    void CourseWorld::build()
+    {
+        // always in hole order, so a collider's index (and with it the order contacts are found in) doesn't
+        // depend on the order holes were added in
+        collisionManager.ClearStaticColliders();
+        colliders.clear();
+        for (const std::vector<BoxCollider>& hole : holeColliders)
+        {
+            colliders.insert(colliders.end(), hole.begin(), hole.end());
+        }
+
+        for (const BoxCollider& collider : colliders)
+        {
+            collisionManager.InsertStaticCollider(new BoxCollider(collider));
+        }
+        collisionManager.buildStaticTree();
+    }
+}
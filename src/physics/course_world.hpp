@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../collision/box_collider.hpp"
+#include "../collision/collision_manager.hpp"
+#include "../lve_scene_description.hpp"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace lve
+{
+    // Everything the ball physics needs to know about a course, without any rendering state.
+    // Shared by the game and the headless simulator
+    struct CourseWorld
+    {
+        CourseWorld() = default;
+        CourseWorld(const CourseWorld&) = delete;
+        CourseWorld& operator=(const CourseWorld&) = delete;
+
+        static constexpr const char* DEFAULT_COURSE = "scenes/course1.scene";
+
+        // loads the shipped 9 hole course: collider files, tees and goal triggers
+        void loadDefaultCourse();
+        // loads the tees, goals and collider files of every hole in the scene, then builds
+        void loadCourse(const SceneDescription& description);
+        // same, for when the collider files have already been read (one list per hole, e.g. on other threads)
+        void loadCourse(const SceneDescription& description, const std::vector<std::vector<BoxCollider>>& collidersPerHole);
+        // appends the colliders from a .boxc file and assigns them to the given hole
+        void loadHoleColliders(const std::string& filename, int courseIndex);
+        void addHoleColliders(const std::vector<BoxCollider>& newColliders, int courseIndex);
+        // (re)inserts the colliders of every hole into the collision manager and builds its tree.
+        // Call once after all holes are loaded
+        void build();
+
+        int getHoleCount() const { return static_cast<int>(tees.size()); }
+
+        CollisionManager collisionManager{};
+
+        // copies of the static colliders currently in the collision manager, in hole order
+        std::vector<BoxCollider> colliders;
+
+        // starting location for each hole
+        std::vector<glm::vec3> tees;
+        // triggers for each golf hole. They're not passed to the collision manager since the simulation
+        // checks them itself once the ball stops
+        std::vector<BoxCollider> goals;
+
+    private:
+        // per hole
+        std::vector<std::vector<BoxCollider>> holeColliders;
+    };
+}
@@ -0,0 +1,115 @@
+#include "island_manager.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace lve
+{
+    IslandManager::BodyId IslandManager::addBody(SleepState* state)
+    {
+        bodies.push_back(state);
+        parents.push_back(static_cast<BodyId>(parents.size()));
+        return static_cast<BodyId>(bodies.size() - 1);
+    }
+
+    void IslandManager::updateBody(BodyId body, glm::vec3 velocity, bool moving, float dt)
+    {
+        SleepState* state = bodies[body];
+        if (state->asleep)
+        {
+            return;
+        }
+
+        if (moving || glm::dot(velocity, velocity) > settings.sleepVelocity * settings.sleepVelocity)
+        {
+            state->restTime = 0.0f;
+        }
+        else
+        {
+            state->restTime += dt;
+        }
+    }
+
+    void IslandManager::addContact(BodyId a, BodyId b)
+    {
+        contacts.push_back({ a, b });
+    }
+
+    void IslandManager::wakeBody(BodyId body)
+    {
+        bodies[body]->wake();
+    }
+
+    IslandManager::BodyId IslandManager::findRoot(BodyId body)
+    {
+        // path halving keeps the trees flat without needing recursion
+        while (parents[body] != body)
+        {
+            parents[body] = parents[parents[body]];
+            body = parents[body];
+        }
+        return body;
+    }
+
+    void IslandManager::merge(BodyId a, BodyId b)
+    {
+        BodyId rootA = findRoot(a);
+        BodyId rootB = findRoot(b);
+        if (rootA != rootB)
+        {
+            parents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+        }
+    }
+
+    void IslandManager::update()
+    {
+        for (BodyId i = 0; i < parents.size(); i++)
+        {
+            parents[i] = i;
+        }
+        for (const auto& contact : contacts)
+        {
+            merge(contact.first, contact.second);
+        }
+        contacts.clear();
+
+        // an island can only sleep if its least rested body has rested long enough.
+        // Bodies that are already asleep count as fully rested
+        islandMinRestTime.assign(bodies.size(), std::numeric_limits<float>::max());
+        islandCount = 0;
+        for (BodyId i = 0; i < bodies.size(); i++)
+        {
+            BodyId root = findRoot(i);
+            if (root == i)
+            {
+                islandCount++;
+            }
+            if (!bodies[i]->asleep)
+            {
+                islandMinRestTime[root] = std::min(islandMinRestTime[root], bodies[i]->restTime);
+            }
+        }
+
+        sleepingCount = 0;
+        for (BodyId i = 0; i < bodies.size(); i++)
+        {
+            BodyId root = findRoot(i);
+            SleepState* state = bodies[i];
+
+            if (islandMinRestTime[root] >= settings.timeToSleep)
+            {
+                state->asleep = true;
+            }
+            else if (state->asleep)
+            {
+                // something in the island is still moving and touching this body, so wake it
+                state->wake();
+            }
+
+            if (state->asleep)
+            {
+                sleepingCount++;
+            }
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace lve
+{
+    // per-body sleep bookkeeping. Owned by whatever controls the body, the island manager only holds a pointer
+    struct SleepState
+    {
+        float restTime = 0.0f;
+        bool asleep = false;
+
+        // call whenever an impulse is applied or the body is teleported
+        void wake()
+        {
+            restTime = 0.0f;
+            asleep = false;
+        }
+    };
+
+    // Groups dynamic bodies that touch each other into simulation islands and decides when an island can sleep.
+    // A sleeping body doesn't need integrating or collision queries at all, so the caller should skip it entirely.
+    // Islands sleep and wake as a whole: one moving body touching a resting group wakes every body in the group
+    class IslandManager
+    {
+    public:
+        using BodyId = uint32_t;
+
+        struct Settings
+        {
+            // bodies slower than this count as resting, once their own simulation has stopped them too
+            float sleepVelocity = 0.1f;
+            // how long every body in an island has to rest before the island sleeps
+            float timeToSleep = 0.5f;
+        };
+
+        BodyId addBody(SleepState* state);
+
+        // accumulate rest time for an awake body. Call once per tick for every body that was simulated.
+        // A body its simulation still has moving never rests, however slow it is, so sleeping can't cut it short
+        void updateBody(BodyId body, glm::vec3 velocity, bool moving, float dt);
+        // report that two dynamic bodies are touching this tick
+        void addContact(BodyId a, BodyId b);
+        void wakeBody(BodyId body);
+
+        // builds the islands from this tick's contacts and puts fully rested islands to sleep.
+        // Contacts are cleared afterwards, so they need to be reported again every tick
+        void update();
+
+        bool isAsleep(BodyId body) const { return bodies[body]->asleep; }
+        size_t getIslandCount() const { return islandCount; }
+        size_t getSleepingCount() const { return sleepingCount; }
+
+        Settings settings{};
+
+    private:
+        BodyId findRoot(BodyId body);
+        void merge(BodyId a, BodyId b);
+
+        std::vector<SleepState*> bodies;
+        std::vector<BodyId> parents;
+        std::vector<std::pair<BodyId, BodyId>> contacts;
+
+        // scratch space reused between updates
+        std::vector<float> islandMinRestTime;
+
+        size_t islandCount = 0;
+        size_t sleepingCount = 0;
+    };
+}
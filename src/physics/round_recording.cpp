@@ -0,0 +1,227 @@
+#include "round_recording.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace lve
+{
+    namespace
+    {
+        constexpr char MAGIC[4] = { 'G', 'R', 'E', 'C' };
+        constexpr uint16_t VERSION = 1;
+
+        // which fields follow the tick's flags byte
+        enum TickFlags : uint8_t
+        {
+            TICK_LAUNCH = 1 << 0,
+            TICK_AIMING = 1 << 1,
+            TICK_TOGGLE_CAMERA = 1 << 2,
+            TICK_AIM_CHANGED = 1 << 3,
+            TICK_POWER_CHANGED = 1 << 4,
+            TICK_DT_CHANGED = 1 << 5,
+        };
+
+        // plain memcpy, so the floats go through bit for bit
+        template <typename T>
+        void write(std::ofstream& file, const T& value)
+        {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            file.write(bytes, sizeof(T));
+        }
+
+        template <typename T>
+        T read(std::ifstream& file, const std::string& filename)
+        {
+            char bytes[sizeof(T)];
+            if (!file.read(bytes, sizeof(T)))
+            {
+                throw std::runtime_error("recording is truncated: " + filename);
+            }
+            T value;
+            std::memcpy(&value, bytes, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void hashValue(uint64_t& hash, const T& value)
+        {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (unsigned char byte : bytes)
+            {
+                hash ^= byte;
+                hash *= 1099511628211ull;
+            }
+        }
+
+        bool sameBits(float a, float b)
+        {
+            return std::memcmp(&a, &b, sizeof(float)) == 0;
+        }
+    }
+
+    void RoundRecording::save(const std::string& filename) const
+    {
+        std::ofstream file{ filename, std::ios::binary };
+        if (!file.is_open())
+        {
+            throw std::runtime_error("failed to open file: " + filename);
+        }
+
+        file.write(MAGIC, sizeof(MAGIC));
+        write(file, VERSION);
+        write(file, seed);
+        write(file, ballRadius);
+        write(file, startPosition.x);
+        write(file, startPosition.y);
+        write(file, startPosition.z);
+        write(file, static_cast<int32_t>(startCourse));
+        write(file, finalStateHash);
+        write(file, static_cast<uint32_t>(ticks.size()));
+
+        TickInput previous{};
+        for (const TickInput& tick : ticks)
+        {
+            uint8_t flags = 0;
+            if (tick.launch) flags |= TICK_LAUNCH;
+            if (tick.aiming) flags |= TICK_AIMING;
+            if (tick.toggleCamera) flags |= TICK_TOGGLE_CAMERA;
+            if (!sameBits(tick.aim.x, previous.aim.x) || !sameBits(tick.aim.y, previous.aim.y)) flags |= TICK_AIM_CHANGED;
+            if (!sameBits(tick.power, previous.power)) flags |= TICK_POWER_CHANGED;
+            if (!sameBits(tick.dt, previous.dt)) flags |= TICK_DT_CHANGED;
+
+            write(file, flags);
+            if (flags & TICK_DT_CHANGED) write(file, tick.dt);
+            if (flags & TICK_AIM_CHANGED)
+            {
+                write(file, tick.aim.x);
+                write(file, tick.aim.y);
+            }
+            if (flags & TICK_POWER_CHANGED) write(file, tick.power);
+
+            previous = tick;
+        }
+
+        if (!file)
+        {
+            throw std::runtime_error("failed to write recording: " + filename);
+        }
+    }
+
+    RoundRecording RoundRecording::load(const std::string& filename)
+    {
+        std::ifstream file{ filename, std::ios::binary };
+        if (!file.is_open())
+        {
+            throw std::runtime_error("failed to open file: " + filename);
+        }
+
+        char magic[sizeof(MAGIC)];
+        if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            throw std::runtime_error("not a round recording: " + filename);
+        }
+        if (read<uint16_t>(file, filename) != VERSION)
+        {
+            throw std::runtime_error("unsupported recording version: " + filename);
+        }
+
+        RoundRecording recording{};
+        recording.seed = read<uint32_t>(file, filename);
+        recording.ballRadius = read<float>(file, filename);
+        recording.startPosition.x = read<float>(file, filename);
+        recording.startPosition.y = read<float>(file, filename);
+        recording.startPosition.z = read<float>(file, filename);
+        recording.startCourse = read<int32_t>(file, filename);
+        recording.finalStateHash = read<uint64_t>(file, filename);
+
+        uint32_t tickCount = read<uint32_t>(file, filename);
+        recording.ticks.reserve(tickCount);
+
+        TickInput tick{};
+        for (uint32_t i = 0; i < tickCount; i++)
+        {
+            uint8_t flags = read<uint8_t>(file, filename);
+            tick.launch = (flags & TICK_LAUNCH) != 0;
+            tick.aiming = (flags & TICK_AIMING) != 0;
+            tick.toggleCamera = (flags & TICK_TOGGLE_CAMERA) != 0;
+            if (flags & TICK_DT_CHANGED) tick.dt = read<float>(file, filename);
+            if (flags & TICK_AIM_CHANGED)
+            {
+                tick.aim.x = read<float>(file, filename);
+                tick.aim.y = read<float>(file, filename);
+            }
+            if (flags & TICK_POWER_CHANGED) tick.power = read<float>(file, filename);
+
+            recording.ticks.push_back(tick);
+        }
+
+        return recording;
+    }
+
+    uint64_t hashBallState(const BallState& state)
+    {
+        // FNV-1a, one field at a time so padding never gets hashed
+        uint64_t hash = 14695981039346656037ull;
+        hashValue(hash, state.position.x);
+        hashValue(hash, state.position.y);
+        hashValue(hash, state.position.z);
+        hashValue(hash, state.velocity.x);
+        hashValue(hash, state.velocity.y);
+        hashValue(hash, state.velocity.z);
+        hashValue(hash, state.previousPos.x);
+        hashValue(hash, state.previousPos.y);
+        hashValue(hash, state.previousPos.z);
+        hashValue(hash, state.currentCourse);
+        hashValue(hash, state.moving);
+        hashValue(hash, state.grounded);
+        hashValue(hash, state.sleep.restTime);
+        hashValue(hash, state.sleep.asleep);
+        return hash;
+    }
+
+    BallSimulation::Settings RoundReplay::makeSettings(float radius)
+    {
+        BallSimulation::Settings settings{};
+        settings.radius = radius;
+        return settings;
+    }
+
+    RoundReplay::RoundReplay(CourseWorld& world, const RoundRecording& recording)
+        : recording{ recording }, simulation{ world, makeSettings(recording.ballRadius) }
+    {
+        state.position = recording.startPosition;
+        state.previousPos = recording.startPosition;
+        state.currentCourse = recording.startCourse;
+        ballBody = islandManager.addBody(&state.sleep);
+    }
+
+    void RoundReplay::saveSnapshot(WorldSnapshot& snapshot) const
+    {
+        snapshot.tick = static_cast<uint32_t>(currentTick);
+        snapshot.ball = state;
+        simulation.saveContactCache(snapshot.contactCache);
+    }
+
+    void RoundReplay::restoreSnapshot(const WorldSnapshot& snapshot)
+    {
+        currentTick = snapshot.tick;
+        state = snapshot.ball;
+        simulation.restoreContactCache(snapshot.contactCache);
+    }
+
+    BallSimulation::StepResult RoundReplay::tick()
+    {
+        // same order as the game loop: the ball steps, then the islands decide who sleeps
+        const TickInput& input = recording.ticks[currentTick++];
+        BallSimulation::StepResult result = simulation.tick(state, input);
+        if (!islandManager.isAsleep(ballBody))
+        {
+            islandManager.updateBody(ballBody, state.velocity, state.moving, input.dt);
+        }
+        islandManager.update();
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ball_simulation.hpp"
+#include "course_world.hpp"
+#include "island_manager.hpp"
+#include "world_snapshot.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace lve
+{
+    // Everything needed to reproduce a round: the random seed, where the ball started and the input for every tick.
+    // Saved as a small binary log, where each tick only stores the fields that changed since the last one
+    struct RoundRecording
+    {
+        uint32_t seed = 0;
+        float ballRadius = 0.06f;
+        glm::vec3 startPosition{ 0.0f };
+        int startCourse = 0;
+
+        std::vector<TickInput> ticks;
+
+        // hash of the ball state at the end of the recording, so a replay can check it ended up in the same place
+        uint64_t finalStateHash = 0;
+
+        void save(const std::string& filename) const;
+        static RoundRecording load(const std::string& filename);
+    };
+
+    // hashes the exact bits of the ball state. Any difference at all in a replay shows up here
+    uint64_t hashBallState(const BallState& state);
+
+    // Re-simulates a recording the same way the game loop runs it, with no window or renderer
+    class RoundReplay
+    {
+    public:
+        RoundReplay(CourseWorld& world, const RoundRecording& recording);
+
+        RoundReplay(const RoundReplay&) = delete;
+        RoundReplay& operator=(const RoundReplay&) = delete;
+
+        bool isDone() const { return currentTick >= recording.ticks.size(); }
+        BallSimulation::StepResult tick();
+
+        const BallState& getState() const { return state; }
+        size_t getTick() const { return currentTick; }
+
+        // rolling back to a snapshot also rewinds the playback position to its tick
+        void saveSnapshot(WorldSnapshot& snapshot) const;
+        void restoreSnapshot(const WorldSnapshot& snapshot);
+
+    private:
+        static BallSimulation::Settings makeSettings(float radius);
+
+        const RoundRecording& recording;
+        BallSimulation simulation;
+        IslandManager islandManager{};
+        IslandManager::BodyId ballBody;
+
+        BallState state{};
+        size_t currentTick = 0;
+    };
+}
@@ -0,0 +1,160 @@
+#include "shot_solver.hpp"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <random>
+
+namespace lve
+{
+    ShotSolver::ShotSolver(CourseWorld& world, LveThreadPool& threadPool)
+        : ShotSolver(world, threadPool, BallSimulation::Settings{})
+    {
+    }
+
+    ShotSolver::ShotSolver(CourseWorld& world, LveThreadPool& threadPool, const BallSimulation::Settings& ballSettings)
+        : world{ world }, threadPool{ threadPool }, ballSettings{ ballSettings }
+    {
+    }
+
+    ShotSolver::Candidate ShotSolver::evaluate(
+        BallSimulation& simulation, const BallState& start, const ShotCommand& shot, const Settings& settings)
+    {
+        Candidate candidate{};
+        candidate.shot = shot;
+
+        BallState state = start;
+        simulation.resetContactCache();
+        simulation.launch(state, shot);
+
+        const glm::vec3 goal = world.goals[start.currentCourse].position;
+
+        float time = 0.0f;
+        while (time < settings.maxShotTime)
+        {
+            float elapsed = settings.timestep;
+            BallSimulation::StepResult result = settings.eventDriven
+                ? simulation.advance(state, settings.timestep, settings.maxShotTime - time, elapsed)
+                : simulation.step(state, settings.timestep);
+            time += elapsed;
+
+            if (result.holed)
+            {
+                candidate.holed = true;
+                candidate.restPosition = goal;
+                candidate.score = -1.0f + time / settings.maxShotTime;
+                return candidate;
+            }
+            if (result.reset || state.position.y > settings.outOfBoundsHeight)
+            {
+                break;
+            }
+            if (result.stopped)
+            {
+                glm::vec3 toGoal = goal - state.position;
+                candidate.restPosition = state.position;
+                candidate.score = glm::length(glm::vec3{ toGoal.x, 0.0f, toGoal.z });
+                return candidate;
+            }
+        }
+
+        // left the course, or still rolling when time ran out
+        candidate.outOfBounds = true;
+        candidate.restPosition = state.position;
+        candidate.score = std::numeric_limits<float>::max();
+        return candidate;
+    }
+
+    std::vector<ShotSolver::Candidate> ShotSolver::solve(const BallState& start, const Settings& settings)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now()
+            + std::chrono::duration_cast<clock::duration>(std::chrono::duration<float, std::milli>(settings.timeBudgetMs));
+
+        std::mt19937 random{ settings.seed };
+        std::uniform_real_distribution<float> unit{ 0.0f, 1.0f };
+
+        const float yawRange = glm::two_pi<float>();
+        const float pitchRange = settings.maxPitch;
+        const float powerRange = settings.maxPower - settings.minPower;
+
+        std::vector<Candidate> best;
+        std::vector<ShotCommand> shots;
+        std::vector<Candidate> results;
+        std::atomic<size_t> evaluated{ 0 };
+
+        float radius = settings.refineRadius;
+        for (int round = 0; round < settings.maxRounds && clock::now() < deadline; round++)
+        {
+            shots.clear();
+            if (round == 0 || best.empty())
+            {
+                // stratify yaw so the first round covers every direction evenly
+                for (int i = 0; i < settings.samplesPerRound; i++)
+                {
+                    float yaw = yawRange * (i + unit(random)) / settings.samplesPerRound;
+                    shots.push_back({ yaw, pitchRange * unit(random), settings.minPower + powerRange * unit(random) });
+                }
+            }
+            else
+            {
+                std::normal_distribution<float> jitter{ 0.0f, radius };
+                int seeds = std::min<int>(settings.refineSeeds, static_cast<int>(best.size()));
+                for (int i = 0; i < settings.samplesPerRound; i++)
+                {
+                    const ShotCommand& seed = best[i % seeds].shot;
+                    ShotCommand shot{};
+                    shot.yaw = glm::mod(seed.yaw + jitter(random) * yawRange, yawRange);
+                    shot.pitch = glm::clamp(seed.pitch + jitter(random) * pitchRange, 0.0f, settings.maxPitch);
+                    shot.power = glm::clamp(seed.power + jitter(random) * powerRange, settings.minPower, settings.maxPower);
+                    shots.push_back(shot);
+                }
+                radius *= settings.refineShrink;
+            }
+
+            results.assign(shots.size(), Candidate{});
+            std::vector<uint8_t> done(shots.size(), 0);
+            threadPool.parallelFor(shots.size(), 16, [&](size_t begin, size_t end)
+            {
+                BallSimulation simulation{ world, ballSettings };
+                size_t count = 0;
+                for (size_t i = begin; i < end; i++)
+                {
+                    // stop picking up new shots once the budget is spent, but keep what's finished
+                    if (clock::now() >= deadline)
+                    {
+                        break;
+                    }
+                    results[i] = evaluate(simulation, start, shots[i], settings);
+                    done[i] = 1;
+                    count++;
+                }
+                evaluated += count;
+            });
+
+            for (size_t i = 0; i < results.size(); i++)
+            {
+                if (done[i] && !results[i].outOfBounds)
+                {
+                    best.push_back(results[i]);
+                }
+            }
+            std::sort(best.begin(), best.end(), [](const Candidate& a, const Candidate& b) { return a.score < b.score; });
+            if (best.size() > static_cast<size_t>(settings.refineSeeds))
+            {
+                best.resize(settings.refineSeeds);
+            }
+        }
+
+        evaluatedCount = evaluated;
+
+        if (best.size() > static_cast<size_t>(settings.resultCount))
+        {
+            best.resize(settings.resultCount);
+        }
+        return best;
+    }
+}
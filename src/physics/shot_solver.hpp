@@ -0,0 +1,78 @@
+#pragma once
+
+#include "ball_simulation.hpp"
+#include "course_world.hpp"
+#include "../lve_thread_pool.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace lve
+{
+    // Searches the (yaw, pitch, power) shot space for the best shots from a given ball state, by running
+    // each candidate through the real ball simulation. Used for the suggested shot hint and AI players.
+    // Candidates are sampled over the whole space first, then refined around the best ones until the
+    // time budget runs out
+    class ShotSolver
+    {
+    public:
+        struct Settings
+        {
+            float timeBudgetMs = 50.0f;
+            // shots evaluated per round. The first round covers the whole space, later ones refine
+            int samplesPerRound = 512;
+            int maxRounds = 8;
+            // how many of the best shots seed each refinement round
+            int refineSeeds = 16;
+            // refinement radius as a fraction of each parameter's range, shrunk every round
+            float refineRadius = 0.1f;
+            float refineShrink = 0.5f;
+
+            float minPower = 0.5f;
+            float maxPower = 10.0f;
+            // the player can only putt flat, so lofted shots are off unless an AI asks for them
+            float maxPitch = 0.0f;
+
+            float timestep = 1.0f / 120.0f;
+            float maxShotTime = 15.0f;
+            // jump straight through flight phases instead of stepping them (see BallSimulation::advance)
+            bool eventDriven = true;
+            // a ball below this height has left the course and is abandoned straight away, instead of
+            // waiting for it to fall to the reset plane
+            float outOfBoundsHeight = 1.5f;
+
+            int resultCount = 5;
+            uint32_t seed = 0;
+        };
+
+        struct Candidate
+        {
+            ShotCommand shot{};
+            // lower is better. Holed shots score below zero, faster ones lower
+            float score = 0.0f;
+            bool holed = false;
+            bool outOfBounds = false;
+            glm::vec3 restPosition{ 0.0f };
+        };
+
+        ShotSolver(CourseWorld& world, LveThreadPool& threadPool);
+        ShotSolver(CourseWorld& world, LveThreadPool& threadPool, const BallSimulation::Settings& ballSettings);
+
+        // returns up to settings.resultCount shots, best first
+        std::vector<Candidate> solve(const BallState& start, const Settings& settings);
+
+        // number of shots simulated by the last solve
+        size_t getEvaluatedCount() const { return evaluatedCount; }
+
+    private:
+        Candidate evaluate(BallSimulation& simulation, const BallState& start, const ShotCommand& shot, const Settings& settings);
+
+        CourseWorld& world;
+        LveThreadPool& threadPool;
+        BallSimulation::Settings ballSettings;
+
+        size_t evaluatedCount = 0;
+    };
+}
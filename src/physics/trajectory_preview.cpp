@@ -0,0 +1,117 @@
+#include "trajectory_preview.hpp"
+
+#include <chrono>
+
+namespace lve
+{
+    TrajectoryPreview::TrajectoryPreview(CourseWorld& world, const BallSimulation::Settings& ballSettings)
+        : simulation{ world, ballSettings }
+    {
+    }
+
+    void TrajectoryPreview::clear()
+    {
+        hasShot = false;
+        complete = true;
+        if (!points.empty())
+        {
+            points.clear();
+            version++;
+        }
+    }
+
+    void TrajectoryPreview::restart(const BallState& start, const ShotCommand& shot)
+    {
+        hasShot = true;
+        lastShot = shot;
+        lastStart = start.position;
+
+        state = start;
+        simulation.resetContactCache();
+        simulation.launch(state, shot);
+        time = 0.0f;
+        bounces = 0;
+        complete = false;
+
+        points.clear();
+        points.push_back(start.position);
+    }
+
+    void TrajectoryPreview::addPoint(glm::vec3 point, bool force)
+    {
+        glm::vec3 delta = point - points.back();
+        if (force || glm::dot(delta, delta) >= settings.pointSpacing * settings.pointSpacing)
+        {
+            points.push_back(point);
+        }
+    }
+
+    bool TrajectoryPreview::update(const BallState& start, const ShotCommand& shot)
+    {
+        bool sameShot = hasShot
+            && shot.yaw == lastShot.yaw
+            && shot.pitch == lastShot.pitch
+            && shot.power == lastShot.power
+            && start.position == lastStart;
+
+        if (sameShot && complete)
+        {
+            return false;
+        }
+
+        size_t pointCount = points.size();
+        if (!sameShot)
+        {
+            restart(start, shot);
+        }
+
+        using clock = std::chrono::steady_clock;
+        const auto deadline = clock::now()
+            + std::chrono::duration_cast<clock::duration>(std::chrono::duration<float, std::milli>(settings.timeBudgetMs));
+
+        int steps = 0;
+        while (!complete)
+        {
+            glm::vec3 previous = state.position;
+            BallSimulation::StepResult result = simulation.step(state, settings.timestep);
+            time += settings.timestep;
+
+            if (result.holed || result.reset)
+            {
+                // the simulation has already moved the ball to the next tee or back, so end on the last real position
+                addPoint(previous, true);
+                complete = true;
+                break;
+            }
+
+            if (result.bounced)
+            {
+                bounces++;
+            }
+            addPoint(state.position, result.bounced);
+
+            if (result.stopped
+                || bounces >= settings.maxBounces
+                || time >= settings.maxTime
+                || state.position.y > settings.outOfBoundsHeight
+                || static_cast<int>(points.size()) >= settings.maxPoints)
+            {
+                complete = true;
+                break;
+            }
+
+            // checking the clock every step would cost more than the steps themselves
+            if (++steps % 16 == 0 && clock::now() >= deadline)
+            {
+                break;
+            }
+        }
+
+        if (!sameShot || points.size() != pointCount)
+        {
+            version++;
+            return true;
+        }
+        return false;
+    }
+}
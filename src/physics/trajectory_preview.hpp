@@ -0,0 +1,65 @@
+#pragma once
+
+#include "ball_simulation.hpp"
+#include "course_world.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace lve
+{
+    // Predicted path for the shot the player is lining up, simulated through the real course colliders.
+    // The path is only recomputed when the shot or the ball changes, and the work is spread over several
+    // frames if it doesn't fit in the per-frame time budget
+    class TrajectoryPreview
+    {
+    public:
+        struct Settings
+        {
+            // the path ends after this many bounces
+            int maxBounces = 3;
+            int maxPoints = 256;
+            // minimum distance between recorded points
+            float pointSpacing = 0.05f;
+            float timestep = 1.0f / 120.0f;
+            float maxTime = 5.0f;
+            // below this height the ball has left the course
+            float outOfBoundsHeight = 1.5f;
+            float timeBudgetMs = 1.0f;
+        };
+
+        TrajectoryPreview(CourseWorld& world, const BallSimulation::Settings& ballSettings);
+
+        // continues or restarts the prediction. Returns true if the path changed
+        bool update(const BallState& start, const ShotCommand& shot);
+        void clear();
+
+        const std::vector<glm::vec3>& getPoints() const { return points; }
+        // changes every time the points do, so renderers know when to re-upload
+        uint64_t getVersion() const { return version; }
+        bool isComplete() const { return complete; }
+
+        Settings settings{};
+
+    private:
+        void restart(const BallState& start, const ShotCommand& shot);
+        void addPoint(glm::vec3 point, bool force);
+
+        BallSimulation simulation;
+
+        bool hasShot = false;
+        ShotCommand lastShot{};
+        glm::vec3 lastStart{ 0.0f };
+
+        // prediction in progress
+        BallState state{};
+        float time = 0.0f;
+        int bounces = 0;
+        bool complete = true;
+
+        std::vector<glm::vec3> points;
+        uint64_t version = 0;
+    };
+}
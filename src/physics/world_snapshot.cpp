@@ -0,0 +1,58 @@
+#include "world_snapshot.hpp"
+
+#include <cassert>
+
+namespace lve
+{
+    SnapshotRing::SnapshotRing(size_t capacity)
+        : snapshots(capacity)
+    {
+        assert(capacity > 0 && "SnapshotRing needs room for at least one snapshot");
+    }
+
+    WorldSnapshot& SnapshotRing::save(uint32_t tick)
+    {
+        WorldSnapshot& snapshot = snapshots[head];
+        snapshot.tick = tick;
+
+        head = (head + 1) % snapshots.size();
+        if (count < snapshots.size())
+        {
+            count++;
+        }
+        return snapshot;
+    }
+
+    const WorldSnapshot* SnapshotRing::find(uint32_t tick) const
+    {
+        if (count == 0)
+        {
+            return nullptr;
+        }
+
+        // ticks are saved in order, so the one we want is a fixed distance back from the newest
+        size_t newest = (head + snapshots.size() - 1) % snapshots.size();
+        uint32_t newestTick = snapshots[newest].tick;
+        if (tick > newestTick || newestTick - tick >= count)
+        {
+            return nullptr;
+        }
+
+        const WorldSnapshot& snapshot = snapshots[(newest + snapshots.size() - (newestTick - tick)) % snapshots.size()];
+        return snapshot.tick == tick ? &snapshot : nullptr;
+    }
+
+    void SnapshotRing::discardFrom(uint32_t tick)
+    {
+        while (count > 0)
+        {
+            size_t newest = (head + snapshots.size() - 1) % snapshots.size();
+            if (snapshots[newest].tick < tick)
+            {
+                break;
+            }
+            head = newest;
+            count--;
+        }
+    }
+}
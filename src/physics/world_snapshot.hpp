@@ -0,0 +1,57 @@
+#pragma once
+
+#include "ball_simulation.hpp"
+#include "contact_solver.hpp"
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace lve
+{
+    // Everything that changes while a round is played, in one flat block with no pointers to follow (the contact
+    // cache names colliders by hole and index, so it survives the course being rebuilt). Taking or restoring a
+    // snapshot is a plain copy. The course itself has no dynamic colliders yet; they belong in here when it does
+    struct WorldSnapshot
+    {
+        uint32_t tick = 0;
+
+        BallState ball{};
+        ContactSolver::WarmStartCache contactCache{};
+
+        // GolfBallController's own state
+        glm::vec3 aimRotation{ 0.0f };
+        float power = 0.0f;
+        bool aiming = false;
+        bool attached = true;
+    };
+
+    static_assert(std::is_trivially_copyable<WorldSnapshot>::value, "WorldSnapshot has to stay plain data");
+
+    // Fixed size history of the last few ticks. Saving a tick overwrites the oldest one, so after warming up
+    // there are no allocations at all
+    class SnapshotRing
+    {
+    public:
+        explicit SnapshotRing(size_t capacity);
+
+        // slot for the given tick, to be filled in by the caller. Ticks are expected to be saved in order
+        WorldSnapshot& save(uint32_t tick);
+        // the snapshot saved for a tick, or nullptr if it's too old or was never saved
+        const WorldSnapshot* find(uint32_t tick) const;
+        // forget the given tick and everything after it, e.g. before resimulating from it
+        void discardFrom(uint32_t tick);
+        void clear() { count = 0; }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return snapshots.size(); }
+
+    private:
+        std::vector<WorldSnapshot> snapshots;
+        // index the next snapshot goes in
+        size_t head = 0;
+        size_t count = 0;
+    };
+}
@@ -64,7 +64,7 @@ namespace lve {
             pipelineConfig);
     }
 
-    void GolfturfRenderSystem::renderGameObjects(FrameInfo &frameInfo, int materialId, float time)
+    void GolfturfRenderSystem::renderGameObjects(FrameInfo &frameInfo, float time)
     {
         lvePipeline->bind(frameInfo.commandBuffer);
 
@@ -78,13 +78,12 @@ namespace lve {
             0,
             nullptr);
 
-        for (auto& kv : frameInfo.gameObjects) {
-            auto& obj = kv.second;
-            if (obj.model == nullptr || !obj.isVisible || obj.materialId != materialId) continue;
+        LveModel* boundModel = nullptr;
+        for (const auto& packet : frameInfo.renderQueue.getPass(LveRenderQueue::Pass::GOLFTURF)) {
             SimplePushConstantData push{};
-            push.modelMatrix = obj.transform.mat4();
-            push.normalMatrix = obj.transform.normalMatrix();
-            push.normalMatrix[3][3] = obj.specular;
+            push.modelMatrix = packet.modelMatrix;
+            push.normalMatrix = packet.normalMatrix;
+            push.normalMatrix[3][3] = packet.specular;
             push.normalMatrix[3][0] = time;
 
             vkCmdPushConstants(frameInfo.commandBuffer,
@@ -93,8 +92,12 @@ namespace lve {
                 0,
                 sizeof(SimplePushConstantData),
                 &push);
-            obj.model->bind(frameInfo.commandBuffer);
-            obj.model->draw(frameInfo.commandBuffer);
+            // sorted by model, so objects sharing a mesh only bind it once
+            if (packet.model != boundModel) {
+                packet.model->bind(frameInfo.commandBuffer);
+                boundModel = packet.model;
+            }
+            packet.model->draw(frameInfo.commandBuffer);
         }
     }
 
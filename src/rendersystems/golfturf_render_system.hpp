@@ -20,7 +20,7 @@ namespace lve {
 		GolfturfRenderSystem(const GolfturfRenderSystem&) = delete;
 		GolfturfRenderSystem& operator=(const GolfturfRenderSystem&) = delete;
 
-		void renderGameObjects(FrameInfo &frameInfo, int materialId, float time);
+		void renderGameObjects(FrameInfo &frameInfo, float time);
 
 	private:
 		void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
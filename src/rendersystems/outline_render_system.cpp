@@ -80,12 +80,11 @@ namespace lve {
             0,
             nullptr);
 
-        for (auto& kv : frameInfo.gameObjects) {
-            auto& obj = kv.second;
-            if (obj.model == nullptr || !obj.isVisible || !obj.outline) continue;
+        LveModel* boundModel = nullptr;
+        for (const auto& packet : frameInfo.renderQueue.getPass(LveRenderQueue::Pass::OUTLINE)) {
             SimplePushConstantData push{};
-            push.modelMatrix = obj.transform.mat4();
-            push.normalMatrix = obj.transform.normalMatrix();
+            push.modelMatrix = packet.modelMatrix;
+            push.normalMatrix = packet.normalMatrix;
 
             vkCmdPushConstants(frameInfo.commandBuffer,
                 pipelineLayout,
@@ -93,8 +92,12 @@ namespace lve {
                 0,
                 sizeof(SimplePushConstantData),
                 &push);
-            obj.model->bind(frameInfo.commandBuffer);
-            obj.model->draw(frameInfo.commandBuffer);
+            // sorted by model, so objects sharing a mesh only bind it once
+            if (packet.model != boundModel) {
+                packet.model->bind(frameInfo.commandBuffer);
+                boundModel = packet.model;
+            }
+            packet.model->draw(frameInfo.commandBuffer);
         }
     }
 
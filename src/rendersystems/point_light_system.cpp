@@ -73,19 +73,20 @@ namespace lve {
         //     frameInfo.frameTime,
         //     {0.0f, -1.0f, 0.0f});
         int lightIndex = 0;
-        for (auto& kv: frameInfo.gameObjects)
+        auto& lights = frameInfo.scene.pointLights;
+        for (size_t i = 0; i < lights.size(); i++)
         {
-            auto& obj = kv.second;
-            if (obj.pointLight == nullptr) continue;
+            auto& light = lights.data()[i];
+            auto& world = frameInfo.scene.getWorldMatrix(lights.entityAt(i));
 
             assert(lightIndex < MAX_LIGHTS && "Point lights exceed maximum specified");
 
             // // update light position
-            // obj.transform.translation = glm::vec3(rotateLight * glm::vec4(obj.transform.translation, 1.0f));
+            // transform.setTranslation(glm::vec3(rotateLight * glm::vec4(transform.getTranslation(), 1.0f)));
 
             // copy light to ubo
-            ubo.pointLights[lightIndex].position = glm::vec4(obj.transform.translation, 1.0f);
-            ubo.pointLights[lightIndex].color = glm::vec4(obj.color, obj.pointLight->lightIntensity);
+            ubo.pointLights[lightIndex].position = world[3];
+            ubo.pointLights[lightIndex].color = glm::vec4(light.color, light.lightIntensity);
 
             lightIndex += 1;
         }
@@ -107,15 +108,16 @@ namespace lve {
             0,
             nullptr);
         
-        for (auto& kv: frameInfo.gameObjects)
+        auto& lights = frameInfo.scene.pointLights;
+        for (size_t i = 0; i < lights.size(); i++)
         {
-            auto& obj = kv.second;
-            if (obj.pointLight == nullptr) continue;
+            auto& light = lights.data()[i];
+            LveScene::Entity entity = lights.entityAt(i);
 
             PointLightPushConstants push{};
-            push.position = glm::vec4(obj.transform.translation, 1.0f);
-            push.color = glm::vec4(obj.color, obj.pointLight->lightIntensity);
-            push.radius = obj.transform.scale.x;
+            push.position = frameInfo.scene.getWorldMatrix(entity)[3];
+            push.color = glm::vec4(light.color, light.lightIntensity);
+            push.radius = frameInfo.scene.transforms.get(entity).getScale().x;
 
             vkCmdPushConstants(
                 frameInfo.commandBuffer,
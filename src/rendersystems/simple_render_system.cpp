@@ -64,7 +64,7 @@ namespace lve {
             pipelineConfig);
     }
 
-    void SimpleRenderSystem::renderGameObjects(FrameInfo &frameInfo, int materialId)
+    void SimpleRenderSystem::renderGameObjects(FrameInfo &frameInfo)
     {
         lvePipeline->bind(frameInfo.commandBuffer);
 
@@ -78,18 +78,17 @@ namespace lve {
             0,
             nullptr);
 
-        for (auto& kv : frameInfo.gameObjects) {
-            auto& obj = kv.second;
-            if (obj.model == nullptr || !obj.isVisible || obj.materialId != materialId) continue;
+        LveModel* boundModel = nullptr;
+        for (const auto& packet : frameInfo.renderQueue.getPass(LveRenderQueue::Pass::SIMPLE)) {
             SimplePushConstantData push{};
-            push.modelMatrix = obj.transform.mat4();
-            push.normalMatrix = obj.transform.normalMatrix();
+            push.modelMatrix = packet.modelMatrix;
+            push.normalMatrix = packet.normalMatrix;
             // fun fact, sending 2 mat4s through push constant data means we are already hitting the
             // 128 byte minimum specs designated by vulkan. My gpu does support an extra 4 bytes
             // but we're also wasting 7x4 bytes by aligning the mat3 normalMatrix as a mat4
             // so I've opted to use one of these empty spots to sneak in a specular value while still
             // remaining under 128 bytes
-            push.normalMatrix[3][3] = obj.specular;
+            push.normalMatrix[3][3] = packet.specular;
 
             vkCmdPushConstants(frameInfo.commandBuffer,
                 pipelineLayout,
@@ -97,8 +96,12 @@ namespace lve {
                 0,
                 sizeof(SimplePushConstantData),
                 &push);
-            obj.model->bind(frameInfo.commandBuffer);
-            obj.model->draw(frameInfo.commandBuffer);
+            // sorted by model, so objects sharing a mesh only bind it once
+            if (packet.model != boundModel) {
+                packet.model->bind(frameInfo.commandBuffer);
+                boundModel = packet.model;
+            }
+            packet.model->draw(frameInfo.commandBuffer);
         }
     }
 
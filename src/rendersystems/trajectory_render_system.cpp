@@ -0,0 +1,137 @@
+#include "trajectory_render_system.hpp"
+
+#include "lve_model.hpp"
+#include "lve_swap_chain.hpp"
+
+// libs
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+// std
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace lve {
+
+    struct TrajectoryPushConstantData
+    {
+        glm::mat4 modelMatrix{ 1.f };
+    };
+
+    TrajectoryRenderSystem::TrajectoryRenderSystem(
+        LveDevice& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, uint32_t maxPoints)
+        : lveDevice{ device }, maxPoints{ maxPoints } {
+        createPipelineLayout(globalSetLayout);
+        createPipeline(renderPass);
+        createVertexBuffers();
+    }
+
+    TrajectoryRenderSystem::~TrajectoryRenderSystem() { vkDestroyPipelineLayout(lveDevice.device(), pipelineLayout, nullptr); }
+
+    void TrajectoryRenderSystem::createPipelineLayout(VkDescriptorSetLayout globalSetLayout) {
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(TrajectoryPushConstantData);
+
+        std::vector<VkDescriptorSetLayout> descriptorSetLayouts{ globalSetLayout };
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+        pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+        if (vkCreatePipelineLayout(lveDevice.device(), &pipelineLayoutInfo, nullptr, &pipelineLayout) !=
+            VK_SUCCESS) {
+            throw std::runtime_error("failed to create pipeline layout!");
+        }
+    }
+
+    void TrajectoryRenderSystem::createPipeline(VkRenderPass renderPass) {
+        assert(pipelineLayout != nullptr && "Cannot create pipeline before pipeline layout");
+
+        PipelineConfigInfo pipelineConfig{};
+        LvePipeline::defaultPipelineConfigInfo(pipelineConfig);
+
+        pipelineConfig.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_LINE_STRIP;
+        // the path should still be hidden behind walls, but it shouldn't hide anything itself
+        pipelineConfig.depthStencilInfo.depthWriteEnable = VK_FALSE;
+
+        pipelineConfig.renderPass = renderPass;
+        pipelineConfig.pipelineLayout = pipelineLayout;
+        lvePipeline = std::make_unique<LvePipeline>(
+            lveDevice,
+            "shaders/unlit_shader.vert.spv",
+            "shaders/unlit_shader.frag.spv",
+            pipelineConfig);
+    }
+
+    void TrajectoryRenderSystem::createVertexBuffers() {
+        vertexBuffers.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
+        vertexCounts.assign(LveSwapChain::MAX_FRAMES_IN_FLIGHT, 0);
+        uploadedVersions.assign(LveSwapChain::MAX_FRAMES_IN_FLIGHT, 0);
+
+        for (auto& buffer : vertexBuffers) {
+            // written every time the path changes, so it lives in host visible memory instead of going through a staging buffer
+            buffer = std::make_unique<LveBuffer>(
+                lveDevice,
+                sizeof(LveModel::Vertex),
+                maxPoints,
+                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+            buffer->map();
+        }
+    }
+
+    void TrajectoryRenderSystem::render(FrameInfo& frameInfo, const std::vector<glm::vec3>& points, uint64_t version)
+    {
+        int frame = frameInfo.frameIndex;
+
+        // each frame in flight has its own buffer, so the one we write here can't still be in use by the gpu
+        if (uploadedVersions[frame] != version) {
+            uint32_t count = std::min(static_cast<uint32_t>(points.size()), maxPoints);
+            std::vector<LveModel::Vertex> vertices(count);
+            for (uint32_t i = 0; i < count; i++) {
+                vertices[i].position = points[i];
+                vertices[i].color = color;
+            }
+            if (count > 0) {
+                vertexBuffers[frame]->writeToBuffer(vertices.data(), sizeof(LveModel::Vertex) * count);
+            }
+            vertexCounts[frame] = count;
+            uploadedVersions[frame] = version;
+        }
+
+        if (vertexCounts[frame] < 2) return;
+
+        lvePipeline->bind(frameInfo.commandBuffer);
+
+        vkCmdBindDescriptorSets(
+            frameInfo.commandBuffer,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            pipelineLayout,
+            0,
+            1,
+            &frameInfo.globalDescriptorSet,
+            0,
+            nullptr);
+
+        TrajectoryPushConstantData push{};
+        vkCmdPushConstants(frameInfo.commandBuffer,
+            pipelineLayout,
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0,
+            sizeof(TrajectoryPushConstantData),
+            &push);
+
+        VkBuffer buffers[] = { vertexBuffers[frame]->getBuffer() };
+        VkDeviceSize offsets[] = { 0 };
+        vkCmdBindVertexBuffers(frameInfo.commandBuffer, 0, 1, buffers, offsets);
+        vkCmdDraw(frameInfo.commandBuffer, vertexCounts[frame], 1, 0, 0);
+    }
+
+}  // namespace lve
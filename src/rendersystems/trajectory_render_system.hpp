@@ -0,0 +1,49 @@
+#pragma once
+
+#include "lve_buffer.hpp"
+#include "lve_camera.hpp"
+#include "lve_device.hpp"
+#include "lve_pipeline.hpp"
+#include "lve_frame_info.hpp"
+
+// libs
+#include <glm/glm.hpp>
+
+// std
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace lve {
+	// draws a predicted ball path as a line strip. The points are streamed into a host visible
+	// vertex buffer (one per frame in flight) whenever the path changes
+	class TrajectoryRenderSystem {
+	public:
+
+		TrajectoryRenderSystem(LveDevice& device, VkRenderPass renderPass, VkDescriptorSetLayout globalSetLayout, uint32_t maxPoints = 256);
+		~TrajectoryRenderSystem();
+
+		TrajectoryRenderSystem(const TrajectoryRenderSystem&) = delete;
+		TrajectoryRenderSystem& operator=(const TrajectoryRenderSystem&) = delete;
+
+		// version should change whenever the points do, so unchanged paths aren't re-uploaded
+		void render(FrameInfo& frameInfo, const std::vector<glm::vec3>& points, uint64_t version);
+
+		glm::vec3 color{ 1.0f, 1.0f, 1.0f };
+
+	private:
+		void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);
+		void createPipeline(VkRenderPass renderPass);
+		void createVertexBuffers();
+
+		LveDevice& lveDevice;
+
+		std::unique_ptr<LvePipeline> lvePipeline;
+		VkPipelineLayout pipelineLayout;
+
+		uint32_t maxPoints;
+		std::vector<std::unique_ptr<LveBuffer>> vertexBuffers;
+		std::vector<uint32_t> vertexCounts;
+		std::vector<uint64_t> uploadedVersions;
+	};
+}  // namespace lve
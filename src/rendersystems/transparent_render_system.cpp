@@ -65,7 +65,7 @@ namespace lve {
             pipelineConfig);
     }
 
-    void TransparentRenderSystem::renderGameObjects(FrameInfo &frameInfo, std::vector<LveGameObject*> gameObjects)
+    void TransparentRenderSystem::renderGameObjects(FrameInfo &frameInfo)
     {
         lvePipeline->bind(frameInfo.commandBuffer);
 
@@ -79,17 +79,18 @@ namespace lve {
             0,
             nullptr);
 
-        for (auto& obj : gameObjects) {
-            if (obj->model == nullptr || !obj->isVisible) continue;
+        // back to front, so the models aren't grouped and usually need rebinding
+        LveModel* boundModel = nullptr;
+        for (const auto& packet : frameInfo.renderQueue.getPass(LveRenderQueue::Pass::ALPHA_BLENDED)) {
             TransparentPushConstantData push{};
-            push.modelMatrix = obj->transform.mat4();
-            push.normalMatrix = obj->transform.normalMatrix();
+            push.modelMatrix = packet.modelMatrix;
+            push.normalMatrix = packet.normalMatrix;
             // fun fact, sending 2 mat4s through push constant data means we are already hitting the
             // 128 byte minimum specs designated by vulkan. My gpu does support an extra 4 bytes
             // but we're also wasting 7x4 bytes by aligning the mat3 normalMatrix as a mat4
             // so I've opted to use one of these empty spots to sneak in an alpha value while still
             // remaining under 128 bytes
-            push.normalMatrix[3][3] = obj->alpha;
+            push.normalMatrix[3][3] = packet.alpha;
 
             vkCmdPushConstants(frameInfo.commandBuffer,
                 pipelineLayout,
@@ -97,8 +98,11 @@ namespace lve {
                 0,
                 sizeof(TransparentPushConstantData),
                 &push);
-            obj->model->bind(frameInfo.commandBuffer);
-            obj->model->draw(frameInfo.commandBuffer);
+            if (packet.model != boundModel) {
+                packet.model->bind(frameInfo.commandBuffer);
+                boundModel = packet.model;
+            }
+            packet.model->draw(frameInfo.commandBuffer);
         }
     }
 
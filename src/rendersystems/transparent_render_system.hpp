@@ -20,7 +20,7 @@ namespace lve {
 		TransparentRenderSystem(const TransparentRenderSystem&) = delete;
 		TransparentRenderSystem& operator=(const TransparentRenderSystem&) = delete;
 
-		void renderGameObjects(FrameInfo &frameInfo, std::vector<LveGameObject*> gameObjects);
+		void renderGameObjects(FrameInfo &frameInfo);
 
 	private:
 		void createPipelineLayout(VkDescriptorSetLayout globalSetLayout);